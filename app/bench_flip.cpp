@@ -0,0 +1,315 @@
+#include "compact_triangulation_2.hpp"
+#include "delaunay.hpp"
+#include "triangulation_2.hpp"
+#include "ra/kernel.hpp"
+#include <CGAL/Cartesian.h>
+#include <CGAL/Simple_cartesian.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmark for the flip phase of delaunay_triangulation (make_delaunay).
+// On jittered grids, it compares the kernel's points represented as
+// reference-counted CGAL::Cartesian handles and as plain
+// CGAL::Simple_cartesian structs. Every point read in the flip loop goes
+// through the vertex to its point; with handles it then goes on to a
+// separately allocated representation, which is one more cache miss per
+// vertex once the triangulation no longer fits in cache. The cache misses
+// themselves are not measured (no performance counters are read); as a
+// proxy, it reports the heap blocks and bytes that each triangulation
+// takes, of which handles add one block per vertex. On lattices, where
+// nearly every quad is cocircular, it compares breaking the ties
+// by preferred directions and by symbolic perturbation. On both, it
+// compares the flip phase with and without the kernel's predicate cache,
+// and reports the share of classifications that the cache answered.
+// Finally, it compares the flip phase and the memory taken by the
+// triangulation with CGAL's halfedge data structure (Triangulation_2) and
+// with the contiguous arrays of Compact_triangulation_2.
+// Build in the Release configuration for meaningful numbers.
+
+namespace {
+
+using Handle_kernel = ra::geometry::Kernel<CGAL::Cartesian<double>>;
+using Plain_kernel = ra::geometry::Kernel<CGAL::Simple_cartesian<double>>;
+
+// Number of times the flip phase is timed for each triangulation; the
+// fastest run is reported.
+constexpr int num_runs = 3;
+
+// A triangulation in OFF format of an n x n grid of points in the unit
+// square, each moved by up to jitter times the grid spacing (at most a
+// fifth, so that no triangle is inverted; if jitter is zero, the points
+// are exactly on a lattice), with each cell split along a random diagonal
+// (so that many of the interior edges must be flipped). The vertices are
+// listed in random order, as they often are in real data; a new
+// representation allocated for each point as it is read is then as
+// scattered as the vertices.
+std::string make_grid( std::mt19937_64& engine, int n, double jitter ) {
+	std::uniform_real_distribution<double> unit(-1.0, 1.0);
+	std::bernoulli_distribution diagonal;
+	int num_vertices = n * n;
+	std::vector<int> order(num_vertices);
+	std::iota( order.begin(), order.end(), 0 );
+	std::shuffle( order.begin(), order.end(), engine );
+	std::vector<int> position(num_vertices);
+	for( int i = 0; i < num_vertices; ++i ) {
+		position[order[i]] = i;
+	}
+	std::ostringstream out;
+	out << std::setprecision(17);
+	out << "OFF\n" << num_vertices << " " << 2 * (n - 1) * (n - 1) << " 0\n";
+	double step = 1.0 / (n - 1);
+	auto move = [&]( bool border ){
+		return (border || (jitter == 0.0)) ? 0.0 : jitter * unit(engine);
+	};
+	for( int v : order ) {
+		int i = v % n;
+		int j = v / n;
+		bool border_x = (i == 0) || (i == n - 1);
+		bool border_y = (j == 0) || (j == n - 1);
+		double x = (i + move(border_x)) * step;
+		double y = (j + move(border_y)) * step;
+		out << x << " " << y << " 0\n";
+	}
+	for( int j = 0; j + 1 < n; ++j ) {
+		for( int i = 0; i + 1 < n; ++i ) {
+			int a = position[j * n + i];
+			int b = position[j * n + i + 1];
+			int c = position[(j + 1) * n + i + 1];
+			int d = position[(j + 1) * n + i];
+			if( diagonal(engine) ) {
+				out << "3 " << a << " " << b << " " << c << "\n";
+				out << "3 " << a << " " << c << " " << d << "\n";
+			}else {
+				out << "3 " << a << " " << b << " " << d << "\n";
+				out << "3 " << b << " " << c << " " << d << "\n";
+			}
+		}
+	}
+	return out.str();
+}
+
+// The number of entries of the predicate cache, as a power of two.
+constexpr unsigned cache_bits = 16;
+
+// The number of bytes and of blocks currently allocated with operator new
+// (see below), for measuring the memory taken by a triangulation.
+std::size_t allocated_bytes = 0;
+std::size_t allocated_blocks = 0;
+
+// The size of the header that records the size of each allocated block,
+// which keeps the blocks aligned as by the default operator new.
+constexpr std::size_t header_size = alignof(std::max_align_t);
+
+// Allocate a block of size bytes after a header recording its size, and
+// count it; return null on failure. Kept out of line, as the compiler
+// would otherwise see the malloc and free calls through the replaced
+// operator new and delete, and warn that they do not match.
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void* counted_allocate( std::size_t size ) {
+	void* block = std::malloc( header_size + size );
+	if( !block ) {
+		return nullptr;
+	}
+	*static_cast<std::size_t*>(block) = size;
+	allocated_bytes += size;
+	++allocated_blocks;
+	return static_cast<char*>(block) + header_size;
+}
+
+// Free a block from counted_allocate, reading its size back from its
+// header; p may be null.
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void counted_free( void* p ) noexcept {
+	if( p ) {
+		void* block = static_cast<char*>(p) - header_size;
+		allocated_bytes -= *static_cast<std::size_t*>(block);
+		--allocated_blocks;
+		std::free( block );
+	}
+}
+
+// The fastest time of the flip phase on the triangulation off, in
+// milliseconds, and the number of flips it performed. The kernel's
+// statistics are those of the last run.
+template<class Kernel, template<class> class Triangulation = trilib::Triangulation_2>
+double flip_ms( const std::string& off, std::size_t& num_flips, bool perturb = false,
+		unsigned cache_bits = 0 ) {
+	double best = 0.0;
+	for( int run = 0; run < num_runs; ++run ) {
+		std::istringstream in(off);
+		Triangulation<Kernel> trangle(in);
+		Kernel::clear_statistics();
+		auto start = std::chrono::steady_clock::now();
+		num_flips = make_delaunay(trangle, perturb, cache_bits);
+		auto stop = std::chrono::steady_clock::now();
+		std::chrono::duration<double, std::milli> elapsed = stop - start;
+		if( run == 0 || elapsed.count() < best ) {
+			best = elapsed.count();
+		}
+	}
+	return best;
+}
+
+// The number of bytes allocated for the triangulation off, once built,
+// and the number of blocks they take.
+template<class Triangulation>
+std::size_t triangulation_bytes( const std::string& off, std::size_t& num_blocks ) {
+	std::istringstream in(off);
+	std::size_t bytes_before = allocated_bytes;
+	std::size_t blocks_before = allocated_blocks;
+	Triangulation trangle(in);
+	num_blocks = allocated_blocks - blocks_before;
+	return allocated_bytes - bytes_before;
+}
+
+void report_memory( std::size_t bytes, std::size_t num_blocks, std::size_t baseline_bytes,
+		std::size_t baseline_blocks ) {
+	std::cout << "  " << baseline_bytes / 1024 << " KiB in " << baseline_blocks
+	  << " blocks and " << bytes / 1024 << " KiB in " << num_blocks << " blocks ("
+	  << std::setprecision(2) << double(baseline_bytes) / bytes << "x less)\n";
+}
+
+void report( const char* name, double ms, std::size_t num_flips, double baseline_ms ) {
+	std::cout << std::left << std::setw(40) << name << std::right
+	  << std::setw(10) << std::fixed << std::setprecision(1) << ms << " ms"
+	  << std::setw(10) << num_flips << " flips"
+	  << std::setw(10) << std::setprecision(2) << baseline_ms / ms << "x\n";
+}
+
+}
+
+// Count the bytes allocated by every (unaligned) operator new and delete.
+// The nothrow forms call these; the sized forms of delete ignore the size
+// and read it from the block's header, as the unsized ones do.
+void* operator new( std::size_t size ) {
+	void* p = counted_allocate( size );
+	if( !p ) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[]( std::size_t size ) {
+	return operator new( size );
+}
+
+void operator delete( void* p ) noexcept {
+	counted_free( p );
+}
+
+void operator delete[]( void* p ) noexcept {
+	counted_free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept {
+	counted_free( p );
+}
+
+void operator delete[]( void* p, std::size_t ) noexcept {
+	counted_free( p );
+}
+
+int main() {
+	std::mt19937_64 engine(475);
+
+	std::cout << "flip phase and memory on jittered grids "
+	  << "(speedup and saving relative to reference-counted points)\n\n";
+
+	for( int n : {100, 300, 600} ) {
+		std::string off = make_grid( engine, n, 0.2 );
+		std::size_t handle_flips = 0;
+		std::size_t plain_flips = 0;
+		double handle_ms = flip_ms<Handle_kernel>( off, handle_flips );
+		double plain_ms = flip_ms<Plain_kernel>( off, plain_flips );
+		std::string grid = std::to_string(n) + "x" + std::to_string(n);
+		std::size_t handle_blocks = 0;
+		std::size_t plain_blocks = 0;
+		std::size_t handle_bytes = triangulation_bytes<trilib::Triangulation_2<Handle_kernel>>(
+		  off, handle_blocks );
+		std::size_t plain_bytes = triangulation_bytes<trilib::Triangulation_2<Plain_kernel>>(
+		  off, plain_blocks );
+		report( (grid + ", CGAL::Cartesian").c_str(), handle_ms, handle_flips, handle_ms );
+		report( (grid + ", CGAL::Simple_cartesian").c_str(), plain_ms, plain_flips, handle_ms );
+		report_memory( plain_bytes, plain_blocks, handle_bytes, handle_blocks );
+	}
+
+	std::cout << "\nflip phase on lattices "
+	  << "(speedup relative to preferred directions)\n\n";
+
+	for( int n : {100, 300, 600} ) {
+		std::string off = make_grid( engine, n, 0.0 );
+		std::size_t preferred_flips = 0;
+		std::size_t perturbed_flips = 0;
+		double preferred_ms = flip_ms<Plain_kernel>( off, preferred_flips );
+		double perturbed_ms = flip_ms<Plain_kernel>( off, perturbed_flips, true );
+		std::string grid = std::to_string(n) + "x" + std::to_string(n);
+		report( (grid + ", preferred directions").c_str(), preferred_ms, preferred_flips,
+		  preferred_ms );
+		report( (grid + ", symbolic perturbation").c_str(), perturbed_ms, perturbed_flips,
+		  preferred_ms );
+	}
+
+	std::cout << "\nflip phase with a predicate cache of 2^" << cache_bits
+	  << " entries (speedup relative to no cache)\n\n";
+
+	for( double jitter : {0.2, 0.0} ) {
+		for( int n : {100, 300, 600} ) {
+			std::string off = make_grid( engine, n, jitter );
+			std::size_t uncached_flips = 0;
+			std::size_t cached_flips = 0;
+			double uncached_ms = flip_ms<Plain_kernel>( off, uncached_flips );
+			double cached_ms = flip_ms<Plain_kernel>( off, cached_flips, false, cache_bits );
+			Plain_kernel::Statistics statistics;
+			Plain_kernel::get_statistics( statistics );
+			std::string grid = std::to_string(n) + "x" + std::to_string(n)
+			  + ((jitter == 0.0) ? " lattice" : " jittered");
+			report( (grid + ", no cache").c_str(), uncached_ms, uncached_flips, uncached_ms );
+			report( (grid + ", cache").c_str(), cached_ms, cached_flips, uncached_ms );
+			std::size_t lookups = statistics.predicate_cache_hit_count
+			  + statistics.predicate_cache_miss_count;
+			std::cout << "  " << statistics.predicate_cache_hit_count << " hits in "
+			  << lookups << " lookups (" << std::setprecision(1)
+			  << 100.0 * statistics.predicate_cache_hit_count / lookups << "%)\n";
+		}
+	}
+
+	std::cout << "\nflip phase and memory by halfedge data structure "
+	  << "(speedup and saving relative to CGAL's)\n\n";
+
+	using Cgal_triangulation = trilib::Triangulation_2<Plain_kernel>;
+	using Compact_triangulation = trilib::Compact_triangulation_2<Plain_kernel>;
+	for( int n : {100, 300, 600} ) {
+		std::string off = make_grid( engine, n, 0.2 );
+		std::size_t cgal_flips = 0;
+		std::size_t compact_flips = 0;
+		double cgal_ms = flip_ms<Plain_kernel>( off, cgal_flips );
+		double compact_ms = flip_ms<Plain_kernel, trilib::Compact_triangulation_2>( off,
+		  compact_flips );
+		std::size_t cgal_blocks = 0;
+		std::size_t compact_blocks = 0;
+		std::size_t cgal_bytes = triangulation_bytes<Cgal_triangulation>( off, cgal_blocks );
+		std::size_t compact_bytes = triangulation_bytes<Compact_triangulation>( off,
+		  compact_blocks );
+		std::string grid = std::to_string(n) + "x" + std::to_string(n);
+		report( (grid + ", Triangulation_2").c_str(), cgal_ms, cgal_flips, cgal_ms );
+		report( (grid + ", Compact_triangulation_2").c_str(), compact_ms, compact_flips,
+		  cgal_ms );
+		report_memory( compact_bytes, compact_blocks, cgal_bytes, cgal_blocks );
+	}
+
+	return 0;
+}
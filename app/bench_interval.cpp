@@ -0,0 +1,237 @@
+#include "ra/interval.hpp"
+#include "ra/packed_interval.hpp"
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Micro-benchmark for interval evaluation of the orientation and
+// side-of-oriented-circle determinants used by ra::geometry::Kernel.
+// Build in the Release configuration for meaningful numbers.
+
+namespace {
+
+// Number of random point sets evaluated per measurement.
+constexpr std::size_t num_samples = 1 << 16;
+
+// Number of passes over the samples per measurement.
+constexpr int num_passes = 20;
+
+// Orientation determinant, written as in ra::geometry::Kernel.
+template<class T>
+T orientation_det( const double* p ) {
+	T ax(p[0]);
+	T ay(p[1]);
+	T bx(p[2]);
+	T by(p[3]);
+	T cx(p[4]);
+	T cy(p[5]);
+	return ( ((ax - cx) * (by - cy)) - ((ay - cy) * (bx - cx)) );
+}
+
+// Side-of-oriented-circle determinant, written as in ra::geometry::Kernel.
+template<class T>
+T side_of_oriented_circle_det( const double* p ) {
+	T ax(p[0]);
+	T ay(p[1]);
+	T az = (ax * ax) + (ay * ay);
+	T bx(p[2]);
+	T by(p[3]);
+	T bz = (bx * bx) + (by * by);
+	T cx(p[4]);
+	T cy(p[5]);
+	T cz = (cx * cx) + (cy * cy);
+	T dx(p[6]);
+	T dy(p[7]);
+	T dz = (dx * dx) + (dy * dy);
+	return ( ((ax - dx) * (((by - dy) * (cz - dz)) - ((bz - dz) * (cy - dy))))
+		- ((bx - dx) * (((ay - dy) * (cz - dz)) - ((az - dz) * (cy - dy))))
+		+ ((cx - dx) * (((ay - dy) * (bz - dz)) - ((az - dz) * (by - dy)))) );
+}
+
+// Time a predicate over all samples and return nanoseconds per call.
+template<class F>
+double ns_per_call( const std::vector<double>& coords, F predicate ) {
+	volatile double sink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for( int pass = 0; pass < num_passes; ++pass ) {
+		for( std::size_t i = 0; i < num_samples; ++i ) {
+			sink = sink + predicate( &coords[8 * i] );
+		}
+	}
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = stop - start;
+	return elapsed.count() / (double(num_samples) * num_passes);
+}
+
+// Time interval multiplication over all pairs of consecutive intervals
+// and return nanoseconds per multiplication.
+template<class Interval, class F>
+double ns_per_multiplication( const std::vector<Interval>& operands, F multiply ) {
+	volatile double sink = 0;
+	auto start = std::chrono::steady_clock::now();
+	for( int pass = 0; pass < num_passes; ++pass ) {
+		for( std::size_t i = 0; i + 1 < operands.size(); ++i ) {
+			Interval product(operands[i]);
+			multiply( product, operands[i + 1] );
+			sink = sink + product.upper();
+		}
+	}
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = stop - start;
+	return elapsed.count() / (double(operands.size() - 1) * num_passes);
+}
+
+// Random intervals whose sign class (negative, straddling zero, or
+// positive) is uniformly distributed, so that a sign-dispatching
+// multiplication cannot predict its branches.
+template<class Interval>
+std::vector<Interval> make_sign_distributed( std::mt19937_64& engine ) {
+	std::uniform_real_distribution<double> magnitude(0.5, 2.0);
+	std::uniform_int_distribution<int> sign_class(0, 2);
+	std::vector<Interval> result;
+	result.reserve(num_samples);
+	for( std::size_t i = 0; i < num_samples; ++i ) {
+		double a = magnitude(engine);
+		double b = magnitude(engine);
+		switch( sign_class(engine) ) {
+			case 0:
+				result.emplace_back( -a - b, -a );
+				break;
+			case 1:
+				result.emplace_back( -a, b );
+				break;
+			default:
+				result.emplace_back( a, a + b );
+		}
+	}
+	return result;
+}
+
+void report( const char* name, double ns, double baseline_ns ) {
+	std::cout << std::left << std::setw(48) << name << std::right
+	  << std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns"
+	  << std::setw(10) << std::setprecision(2) << baseline_ns / ns << "x\n";
+}
+
+}
+
+int main() {
+	using checked = ra::math::interval<double>;
+	using unchecked = ra::math::interval<double, ra::math::protected_rounding<double>>;
+	using negated_checked = ra::math::interval<double, ra::math::checked_rounding<double>,
+	  ra::math::negated_lower_storage>;
+	using negated_unchecked = ra::math::interval<double, ra::math::protected_rounding<double>,
+	  ra::math::negated_lower_storage>;
+#if defined(__SSE2__)
+	using packed_unchecked = ra::math::interval<double, ra::math::protected_rounding<double>,
+	  ra::math::packed_storage>;
+#endif
+
+	std::mt19937_64 engine(475);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	std::vector<double> coords(8 * num_samples);
+	for( auto& x : coords ) {
+		x = dist(engine);
+	}
+
+	std::cout << "interval predicate cost (speedup relative to checked rounding)\n\n";
+
+	// Orientation
+	double orient_checked = ns_per_call( coords, []( const double* p ) {
+		return orientation_det<checked>(p).upper();
+	});
+	double orient_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return orientation_det<unchecked>(p).upper();
+	});
+	double orient_negated = ns_per_call( coords, []( const double* p ) {
+		return orientation_det<negated_checked>(p).upper();
+	});
+	double orient_negated_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return orientation_det<negated_unchecked>(p).upper();
+	});
+	report( "orientation, checked rounding", orient_checked, orient_checked );
+	report( "orientation, rounding region", orient_region, orient_checked );
+	report( "orientation, negated lower", orient_negated, orient_checked );
+	report( "orientation, negated lower, rounding region", orient_negated_region, orient_checked );
+#if defined(__SSE2__)
+	double orient_packed_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return orientation_det<packed_unchecked>(p).upper();
+	});
+	report( "orientation, packed SSE2, rounding region", orient_packed_region, orient_checked );
+#endif
+
+	// Side of oriented circle
+	double circle_checked = ns_per_call( coords, []( const double* p ) {
+		return side_of_oriented_circle_det<checked>(p).upper();
+	});
+	double circle_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return side_of_oriented_circle_det<unchecked>(p).upper();
+	});
+	double circle_negated = ns_per_call( coords, []( const double* p ) {
+		return side_of_oriented_circle_det<negated_checked>(p).upper();
+	});
+	double circle_negated_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return side_of_oriented_circle_det<negated_unchecked>(p).upper();
+	});
+	report( "side_of_oriented_circle, checked rounding", circle_checked, circle_checked );
+	report( "side_of_oriented_circle, rounding region", circle_region, circle_checked );
+	report( "side_of_oriented_circle, negated lower", circle_negated, circle_checked );
+	report( "side_of_oriented_circle, negated lower, region", circle_negated_region, circle_checked );
+#if defined(__SSE2__)
+	double circle_packed_region = ns_per_call( coords, []( const double* p ) {
+		ra::math::rounding_region region;
+		return side_of_oriented_circle_det<packed_unchecked>(p).upper();
+	});
+	report( "side_of_oriented_circle, packed SSE2, region", circle_packed_region, circle_checked );
+#endif
+
+	std::cout << "\ninterval multiplication on sign-distributed inputs "
+	  << "(speedup relative to lookup switch)\n\n";
+	{
+		auto operands = make_sign_distributed<checked>( engine );
+		double lookup = ns_per_multiplication( operands, []( checked& a, const checked& b ) {
+			a.multiply_by_lookup(b);
+		});
+		double branchless = ns_per_multiplication( operands, []( checked& a, const checked& b ) {
+			a.multiply_branchless(b);
+		});
+		report( "checked rounding, lookup switch", lookup, lookup );
+		report( "checked rounding, branchless", branchless, lookup );
+	}
+	{
+		auto operands = make_sign_distributed<unchecked>( engine );
+		ra::math::rounding_region region;
+		double lookup = ns_per_multiplication( operands, []( unchecked& a, const unchecked& b ) {
+			a.multiply_by_lookup(b);
+		});
+		double branchless = ns_per_multiplication( operands, []( unchecked& a, const unchecked& b ) {
+			a.multiply_branchless(b);
+		});
+		report( "rounding region, lookup switch", lookup, lookup );
+		report( "rounding region, branchless", branchless, lookup );
+	}
+	{
+		auto operands = make_sign_distributed<negated_unchecked>( engine );
+		ra::math::rounding_region region;
+		double lookup = ns_per_multiplication( operands,
+		  []( negated_unchecked& a, const negated_unchecked& b ) {
+			a.multiply_by_lookup(b);
+		});
+		double branchless = ns_per_multiplication( operands,
+		  []( negated_unchecked& a, const negated_unchecked& b ) {
+			a.multiply_branchless(b);
+		});
+		report( "negated lower, region, lookup switch", lookup, lookup );
+		report( "negated lower, region, branchless", branchless, lookup );
+	}
+
+	return 0;
+}
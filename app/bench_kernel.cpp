@@ -0,0 +1,755 @@
+#include "ra/kernel.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Benchmark for ra::geometry::Kernel predicates on degenerate inputs
+// (collinear lattice points and cocircular points), where a large share
+// of tests fall back to exact arithmetic. The kernel is compared with
+// the exception-based filtering it used to perform, in which a failed
+// interval filter threw indeterminate_result and the exact evaluation ran
+// in the handler, with the kernel using MP_Float or a fixed-size bigfloat
+// rather than floating-point expansions for its exact stage, and with a
+// shorter filter chain. Build in the Release configuration for meaningful
+// numbers.
+
+namespace {
+
+using Kernel = ra::geometry::Kernel<double>;
+using Point = Kernel::Point;
+using Interval = ra::geometry::default_interval<double>::type;
+using Exact = CGAL::MP_Float;
+
+// The default chain, with MP_Float rather than expansions for its exact
+// stage.
+using MP_Float_kernel = ra::geometry::Kernel<double, ra::geometry::static_filter<double>,
+  ra::geometry::interval_filter<Interval>, ra::geometry::double_double_filter,
+  ra::geometry::exact_filter<ra::geometry::number_type_exact<Exact>>>;
+
+#if defined(__SIZEOF_INT128__)
+// The default chain, with a fixed-size bigfloat for its exact stage.
+using Bigfloat_kernel = ra::geometry::Kernel<double, ra::geometry::static_filter<double>,
+  ra::geometry::interval_filter<Interval>, ra::geometry::double_double_filter,
+  ra::geometry::exact_filter<ra::geometry::bounded_number_type_exact<ra::math::bigfloat<18>,
+  ra::geometry::number_type_exact<Exact>>>>;
+#endif
+
+// A chain going straight from interval arithmetic to the exact stage.
+using Interval_exact_kernel = ra::geometry::Kernel<double,
+  ra::geometry::interval_filter<Interval>,
+  ra::geometry::exact_filter<ra::geometry::default_exact<double>::type>>;
+
+// The interval stage as it was before side_of_oriented_circle translated
+// d to the origin first: it lifts the untranslated points, squaring
+// coordinates that may be much larger than their differences.
+class Raw_lift_interval_filter : public ra::geometry::interval_filter<Interval> {
+	public:
+		static constexpr const char* name = "interval (raw lifts)";
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			ra::math::rounding_region region;
+			Interval ax(a.x()), ay(a.y()), bx(b.x()), by(b.y());
+			Interval cx(c.x()), cy(c.y()), dx(d.x()), dy(d.y());
+			Interval az = (ax * ax) + (ay * ay);
+			Interval bz = (bx * bx) + (by * by);
+			Interval cz = (cx * cx) + (cy * cy);
+			Interval dz = (dx * dx) + (dy * dy);
+			return ( ((ax - dx) * (((by - dy) * (cz - dz)) - ((bz - dz) * (cy - dy))))
+			  - ((bx - dx) * (((ay - dy) * (cz - dz)) - ((az - dz) * (cy - dy))))
+			  + ((cx - dx) * (((ay - dy) * (bz - dz)) - ((az - dz) * (by - dy)))) )
+			  .sign_or_uncertain();
+		}
+};
+
+// Interval_exact_kernel with the raw-lift interval stage.
+using Raw_lift_kernel = ra::geometry::Kernel<double, Raw_lift_interval_filter,
+  ra::geometry::exact_filter<ra::geometry::default_exact<double>::type>>;
+
+// The kernel over float with the chain it used before promoting float
+// coordinates to double: every stage but the last evaluates in float.
+using Float_kernel = ra::geometry::Kernel<float>;
+using Float_point = Float_kernel::Point;
+using Unpromoted_float_kernel = ra::geometry::Kernel<float, ra::geometry::static_filter<float>,
+  ra::geometry::interval_filter<ra::geometry::default_interval<float>::type>,
+  ra::geometry::double_double_filter,
+  ra::geometry::exact_filter<ra::geometry::default_exact<float>::type>>;
+
+// The kernel over integer coordinates (such as those snapped to a grid).
+using Integer_kernel = ra::geometry::Kernel<std::int32_t>;
+using Integer_point = Integer_kernel::Point;
+
+// Number of point sets evaluated per measurement.
+constexpr std::size_t num_samples = 1 << 14;
+
+// Number of passes over the samples per measurement.
+constexpr int num_passes = 10;
+
+// Side length of the lattice from which grid points are taken.
+constexpr int grid_size = 1000;
+
+// Lattice spacing. The lattice spans the unit square; its coordinates are
+// not exactly representable, so the interval filter fails on degenerate
+// configurations.
+constexpr double grid_step = 1.0 / grid_size;
+
+template<class T>
+T orientation_det( const Point& a, const Point& b, const Point& c ) {
+	T ax(a.x());
+	T ay(a.y());
+	T bx(b.x());
+	T by(b.y());
+	T cx(c.x());
+	T cy(c.y());
+	return ( ((ax - cx) * (by - cy)) - ((ay - cy) * (bx - cx)) );
+}
+
+template<class T>
+T side_of_oriented_circle_det( const Point& a, const Point& b, const Point& c,
+  const Point& d ) {
+	T ax(a.x());
+	T ay(a.y());
+	T az = (ax * ax) + (ay * ay);
+	T bx(b.x());
+	T by(b.y());
+	T bz = (bx * bx) + (by * by);
+	T cx(c.x());
+	T cy(c.y());
+	T cz = (cx * cx) + (cy * cy);
+	T dx(d.x());
+	T dy(d.y());
+	T dz = (dx * dx) + (dy * dy);
+	return ( ((ax - dx) * (((by - dy) * (cz - dz)) - ((bz - dz) * (cy - dy))))
+		- ((bx - dx) * (((ay - dy) * (cz - dz)) - ((az - dz) * (cy - dy))))
+		+ ((cx - dx) * (((ay - dy) * (bz - dz)) - ((az - dz) * (by - dy)))) );
+}
+
+int exact_sign( const Exact& x ) {
+	if( Exact(0) < x ) {
+		return 1;
+	}else if( x < Exact(0) ) {
+		return -1;
+	}else {
+		return 0;
+	}
+}
+
+// The filtering formerly used by the kernel.
+int throwing_orientation( const Point& a, const Point& b, const Point& c ) {
+	try {
+		ra::math::rounding_region region;
+		return orientation_det<Interval>(a, b, c).sign();
+	}
+	catch( ra::math::indeterminate_result& e ) {
+		return exact_sign( orientation_det<Exact>(a, b, c) );
+	}
+}
+
+int throwing_side_of_oriented_circle( const Point& a, const Point& b,
+  const Point& c, const Point& d ) {
+	try {
+		ra::math::rounding_region region;
+		return side_of_oriented_circle_det<Interval>(a, b, c, d).sign();
+	}
+	catch( ra::math::indeterminate_result& e ) {
+		return exact_sign( side_of_oriented_circle_det<Exact>(a, b, c, d) );
+	}
+}
+
+// Time a predicate over all samples (groups of k points, or of k vertex
+// handles) and return nanoseconds per call.
+template<class T, class F>
+double ns_per_call( const std::vector<T>& points, std::size_t k, F predicate ) {
+	volatile int sink = 0;
+	std::size_t n = points.size() / k;
+	auto start = std::chrono::steady_clock::now();
+	for( int pass = 0; pass < num_passes; ++pass ) {
+		for( std::size_t i = 0; i < n; ++i ) {
+			sink = sink + predicate( &points[k * i] );
+		}
+	}
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = stop - start;
+	return elapsed.count() / (double(n) * num_passes);
+}
+
+// Time a batched predicate over n tests and return nanoseconds per test.
+template<class F>
+double ns_per_test( std::size_t n, F batch ) {
+	auto start = std::chrono::steady_clock::now();
+	for( int pass = 0; pass < num_passes; ++pass ) {
+		batch();
+	}
+	auto stop = std::chrono::steady_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = stop - start;
+	return elapsed.count() / (double(n) * num_passes);
+}
+
+// Triples of lattice points, half of which are collinear.
+std::vector<Point> make_grid_triples( std::mt19937_64& engine ) {
+	std::uniform_int_distribution<int> coord(0, grid_size - 1);
+	std::uniform_int_distribution<int> step(-3, 3);
+	std::vector<Point> result;
+	result.reserve(3 * num_samples);
+	for( std::size_t i = 0; i < num_samples; ++i ) {
+		int ax = coord(engine);
+		int ay = coord(engine);
+		int dx = step(engine);
+		int dy = step(engine);
+		result.emplace_back( ax * grid_step, ay * grid_step );
+		result.emplace_back( (ax + dx) * grid_step, (ay + dy) * grid_step );
+		if( i % 2 ) {
+			result.emplace_back( (ax + 2 * dx) * grid_step, (ay + 2 * dy) * grid_step );
+		}else {
+			result.emplace_back( coord(engine) * grid_step, coord(engine) * grid_step );
+		}
+	}
+	return result;
+}
+
+// Triples of widely spaced lattice points on a line, with the last point
+// moved off the line by one unit in the last place. The determinant is
+// then too small relative to the coordinates for the floating-point and
+// interval filters, but not for double-double arithmetic.
+std::vector<Point> make_near_collinear_triples( std::mt19937_64& engine ) {
+	std::uniform_int_distribution<int> coord(0, grid_size / 3);
+	std::uniform_int_distribution<int> step(grid_size / 6, grid_size / 3);
+	std::vector<Point> result;
+	result.reserve(3 * num_samples);
+	for( std::size_t i = 0; i < num_samples; ++i ) {
+		int ax = coord(engine);
+		int ay = coord(engine);
+		int dx = step(engine);
+		int dy = step(engine);
+		double cy = (ay + 2 * dy) * grid_step;
+		result.emplace_back( ax * grid_step, ay * grid_step );
+		result.emplace_back( (ax + dx) * grid_step, (ay + dy) * grid_step );
+		result.emplace_back( (ax + 2 * dx) * grid_step, std::nextafter(cy, 2.0) );
+	}
+	return result;
+}
+
+// Quadruples of lattice points, half of which are the corners of an
+// axis-aligned rectangle (and so exactly cocircular, even after rounding
+// to double).
+std::vector<Point> make_cocircular_quads( std::mt19937_64& engine ) {
+	std::uniform_int_distribution<int> coord(0, grid_size - 1);
+	std::uniform_int_distribution<int> extent(1, 50);
+	std::vector<Point> result;
+	result.reserve(4 * num_samples);
+	for( std::size_t i = 0; i < num_samples; ++i ) {
+		double x = coord(engine) * grid_step;
+		double y = coord(engine) * grid_step;
+		double x2 = extent(engine) * grid_step + x;
+		double y2 = extent(engine) * grid_step + y;
+		result.emplace_back( x, y );
+		result.emplace_back( x2, y );
+		result.emplace_back( x2, y2 );
+		result.emplace_back( (i % 2) ? x : x - grid_step, y2 );
+	}
+	return result;
+}
+
+// Quadrilaterals abcd formed by two adjacent triangles abc and cda of a
+// triangulation (both counterclockwise), with corners uniformly
+// distributed in the unit square, as tested by the Lawson flip loop.
+std::vector<Point> make_triangle_pairs( std::mt19937_64& engine ) {
+	std::uniform_real_distribution<double> coord(0.0, 1.0);
+	auto left_of = []( const Point& p, const Point& q, const Point& r ) {
+		return (q.x() - p.x()) * (r.y() - p.y()) > (q.y() - p.y()) * (r.x() - p.x());
+	};
+	std::vector<Point> result;
+	result.reserve(4 * num_samples);
+	while( result.size() < 4 * num_samples ) {
+		Point a( coord(engine), coord(engine) );
+		Point b( coord(engine), coord(engine) );
+		Point c( coord(engine), coord(engine) );
+		Point d( coord(engine), coord(engine) );
+		if( !left_of(a, b, c) ) {
+			std::swap( a, c );
+		}
+		if( left_of(c, d, a) && left_of(a, b, c) ) {
+			result.push_back( a );
+			result.push_back( b );
+			result.push_back( c );
+			result.push_back( d );
+		}
+	}
+	return result;
+}
+
+// Groups of k points uniformly distributed in the unit square.
+std::vector<Point> make_random( std::mt19937_64& engine, std::size_t k ) {
+	std::uniform_real_distribution<double> coord(0.0, 1.0);
+	std::vector<Point> result;
+	result.reserve(k * num_samples);
+	for( std::size_t i = 0; i < k * num_samples; ++i ) {
+		result.emplace_back( coord(engine), coord(engine) );
+	}
+	return result;
+}
+
+// Groups of k points uniformly distributed in the unit square moved to
+// (offset, offset), as in georeferenced data.
+std::vector<Point> make_offset( std::mt19937_64& engine, std::size_t k, double offset ) {
+	std::uniform_real_distribution<double> coord(0.0, 1.0);
+	std::vector<Point> result;
+	result.reserve(k * num_samples);
+	for( std::size_t i = 0; i < k * num_samples; ++i ) {
+		result.emplace_back( offset + coord(engine), offset + coord(engine) );
+	}
+	return result;
+}
+
+// The points rounded to float.
+std::vector<Float_point> to_float( const std::vector<Point>& points ) {
+	std::vector<Float_point> result;
+	result.reserve(points.size());
+	for( const Point& p : points ) {
+		result.emplace_back( float(p.x()), float(p.y()) );
+	}
+	return result;
+}
+
+// The points in units of grid_step (the lattice coordinates of grid
+// points), as integers and as doubles.
+std::vector<Integer_point> to_grid( const std::vector<Point>& points ) {
+	std::vector<Integer_point> result;
+	result.reserve(points.size());
+	for( const Point& p : points ) {
+		result.emplace_back( std::int32_t(std::lround(p.x() * grid_size)),
+		  std::int32_t(std::lround(p.y() * grid_size)) );
+	}
+	return result;
+}
+
+std::vector<Point> to_double( const std::vector<Integer_point>& points ) {
+	std::vector<Point> result;
+	result.reserve(points.size());
+	for( const Integer_point& p : points ) {
+		result.emplace_back( p.x(), p.y() );
+	}
+	return result;
+}
+
+// Groups of K random indices of points in a pool of size num_points.
+template<std::size_t K>
+std::vector<std::array<unsigned, K>> make_index_groups( std::mt19937_64& engine,
+  unsigned num_points ) {
+	std::uniform_int_distribution<unsigned> index(0, num_points - 1);
+	std::vector<std::array<unsigned, K>> result(num_samples);
+	for( std::array<unsigned, K>& group : result ) {
+		for( unsigned& i : group ) {
+			i = index(engine);
+		}
+	}
+	return result;
+}
+
+void report( const char* name, double ns, double baseline_ns ) {
+	std::cout << std::left << std::setw(56) << name << std::right
+	  << std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns"
+	  << std::setw(10) << std::setprecision(2) << baseline_ns / ns << "x\n";
+}
+
+// Nothing is reported when statistics are disabled.
+void report_rates( std::size_t interval, std::size_t double_double, std::size_t exact,
+  std::size_t total ) {
+	if( total == 0 ) {
+		return;
+	}
+	std::cout << "  interval stage: " << std::setprecision(1)
+	  << 100.0 * double(interval) / double(total) << "%, double-double stage: "
+	  << 100.0 * double(double_double) / double(total) << "%, exact fallbacks: "
+	  << 100.0 * double(exact) / double(total) << "%\n";
+}
+
+// The share of tests of one predicate (selected by field) reaching each
+// stage of the filter chain of K. Nothing is reported when statistics are
+// disabled.
+template<class K>
+void report_stages( std::size_t K::Stage_statistics::* field ) {
+	typename K::Chain_statistics stages;
+	K::get_stage_statistics( stages );
+	std::size_t total = stages[0].*field;
+	if( total == 0 ) {
+		return;
+	}
+	const char* separator = "  ";
+	for( const auto& stage : stages ) {
+		std::cout << separator << stage.name << " stage: " << std::setprecision(1)
+		  << 100.0 * double(stage.*field) / double(total) << "%";
+		separator = ", ";
+	}
+	std::cout << '\n';
+}
+
+}
+
+int main() {
+	std::mt19937_64 engine(475);
+	Kernel kernel;
+	MP_Float_kernel mp_float_kernel;
+#if defined(__SIZEOF_INT128__)
+	Bigfloat_kernel bigfloat_kernel;
+#endif
+	Interval_exact_kernel interval_exact_kernel;
+	Kernel::Statistics stats;
+
+	std::cout << "kernel predicate cost on degenerate inputs "
+	  << "(speedup relative to exception-based filtering)\n\n";
+
+	{
+		auto points = make_grid_triples( engine );
+		double throwing = ns_per_call( points, 3, []( const Point* p ) {
+			return throwing_orientation( p[0], p[1], p[2] );
+		});
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 3, [&kernel]( const Point* p ) {
+			return static_cast<int>(kernel.orientation( p[0], p[1], p[2] ));
+		});
+		Kernel::get_statistics( stats );
+		double mp_float_ns = ns_per_call( points, 3, [&mp_float_kernel]( const Point* p ) {
+			return static_cast<int>(mp_float_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		report( "orientation, grid, exceptions", throwing, throwing );
+		report( "orientation, grid, kernel (MP_Float)", mp_float_ns, throwing );
+#if defined(__SIZEOF_INT128__)
+		double bigfloat_ns = ns_per_call( points, 3, [&bigfloat_kernel]( const Point* p ) {
+			return static_cast<int>(bigfloat_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		report( "orientation, grid, kernel (bigfloat)", bigfloat_ns, throwing );
+#endif
+		report( "orientation, grid, kernel", kernel_ns, throwing );
+		report_rates( stats.orientation_interval_count,
+		  stats.orientation_double_double_count, stats.orientation_exact_count,
+		  stats.orientation_total_count );
+		Interval_exact_kernel::clear_statistics();
+		double interval_exact_ns = ns_per_call( points, 3, [&interval_exact_kernel]( const Point* p ) {
+			return static_cast<int>(interval_exact_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		report( "orientation, grid, interval -> exact", interval_exact_ns, throwing );
+		report_stages<Interval_exact_kernel>( &Interval_exact_kernel::Stage_statistics::orientation_count );
+	}
+
+	{
+		auto points = make_near_collinear_triples( engine );
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 3, [&kernel]( const Point* p ) {
+			return static_cast<int>(kernel.orientation( p[0], p[1], p[2] ));
+		});
+		Kernel::get_statistics( stats );
+		double mp_float_ns = ns_per_call( points, 3, [&mp_float_kernel]( const Point* p ) {
+			return static_cast<int>(mp_float_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		double throwing = ns_per_call( points, 3, []( const Point* p ) {
+			return throwing_orientation( p[0], p[1], p[2] );
+		});
+		report( "orientation, near collinear, exceptions", throwing, throwing );
+		report( "orientation, near collinear, kernel (MP_Float)", mp_float_ns, throwing );
+		report( "orientation, near collinear, kernel", kernel_ns, throwing );
+		report_rates( stats.orientation_interval_count,
+		  stats.orientation_double_double_count, stats.orientation_exact_count,
+		  stats.orientation_total_count );
+		Interval_exact_kernel::clear_statistics();
+		double interval_exact_ns = ns_per_call( points, 3, [&interval_exact_kernel]( const Point* p ) {
+			return static_cast<int>(interval_exact_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		report( "orientation, near collinear, interval -> exact", interval_exact_ns, throwing );
+		report_stages<Interval_exact_kernel>( &Interval_exact_kernel::Stage_statistics::orientation_count );
+	}
+
+	{
+		auto points = make_cocircular_quads( engine );
+		double throwing = ns_per_call( points, 4, []( const Point* p ) {
+			return throwing_side_of_oriented_circle( p[0], p[1], p[2], p[3] );
+		});
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 4, [&kernel]( const Point* p ) {
+			return static_cast<int>(kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+		});
+		Kernel::get_statistics( stats );
+		double mp_float_ns = ns_per_call( points, 4, [&mp_float_kernel]( const Point* p ) {
+			return static_cast<int>(mp_float_kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+		});
+		report( "side_of_oriented_circle, cocircular, exceptions", throwing, throwing );
+		report( "side_of_oriented_circle, cocircular, kernel (MP_Float)", mp_float_ns, throwing );
+#if defined(__SIZEOF_INT128__)
+		double bigfloat_ns = ns_per_call( points, 4, [&bigfloat_kernel]( const Point* p ) {
+			return static_cast<int>(bigfloat_kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+		});
+		report( "side_of_oriented_circle, cocircular, kernel (bigfloat)", bigfloat_ns, throwing );
+#endif
+		report( "side_of_oriented_circle, cocircular, kernel", kernel_ns, throwing );
+		report_rates( stats.side_of_oriented_circle_interval_count,
+		  stats.side_of_oriented_circle_double_double_count,
+		  stats.side_of_oriented_circle_exact_count, stats.side_of_oriented_circle_total_count );
+	}
+
+	// Random points lie in the unit square
+	Kernel bbox_kernel;
+	bbox_kernel.configure_for_bbox( 1.0 );
+
+	std::cout << "\nkernel predicate cost on random inputs "
+	  << "(speedup relative to an unconfigured kernel)\n\n";
+
+	{
+		auto points = make_random( engine, 3 );
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 3, [&kernel]( const Point* p ) {
+			return static_cast<int>(kernel.orientation( p[0], p[1], p[2] ));
+		});
+		Kernel::get_statistics( stats );
+		report( "orientation, random, kernel", kernel_ns, kernel_ns );
+		report_rates( stats.orientation_interval_count,
+		  stats.orientation_double_double_count, stats.orientation_exact_count,
+		  stats.orientation_total_count );
+		double bbox_ns = ns_per_call( points, 3, [&bbox_kernel]( const Point* p ) {
+			return static_cast<int>(bbox_kernel.orientation( p[0], p[1], p[2] ));
+		});
+		report( "orientation, random, bbox kernel", bbox_ns, kernel_ns );
+	}
+
+	{
+		auto points = make_random( engine, 4 );
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 4, [&kernel]( const Point* p ) {
+			return static_cast<int>(kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+		});
+		Kernel::get_statistics( stats );
+		report( "side_of_oriented_circle, random, kernel", kernel_ns, kernel_ns );
+		report_rates( stats.side_of_oriented_circle_interval_count,
+		  stats.side_of_oriented_circle_double_double_count,
+		  stats.side_of_oriented_circle_exact_count, stats.side_of_oriented_circle_total_count );
+		double bbox_ns = ns_per_call( points, 4, [&bbox_kernel]( const Point* p ) {
+			return static_cast<int>(bbox_kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+		});
+		report( "side_of_oriented_circle, random, bbox kernel", bbox_ns, kernel_ns );
+	}
+
+	{
+		auto points = make_random( engine, 4 );
+		Kernel::Vector v(1, 1);
+		Kernel::clear_statistics();
+		double kernel_ns = ns_per_call( points, 4, [&kernel, &v]( const Point* p ) {
+			return kernel.preferred_direction( p[0], p[1], p[2], p[3], v );
+		});
+		Kernel::get_statistics( stats );
+		report( "preferred_direction, random, kernel", kernel_ns, kernel_ns );
+		report_rates( stats.preferred_direction_interval_count,
+		  stats.preferred_direction_double_double_count,
+		  stats.preferred_direction_exact_count, stats.preferred_direction_total_count );
+		Kernel::clear_statistics();
+		double bbox_ns = ns_per_call( points, 4, [&bbox_kernel, &v]( const Point* p ) {
+			return bbox_kernel.preferred_direction( p[0], p[1], p[2], p[3], v );
+		});
+		Kernel::get_statistics( stats );
+		report( "preferred_direction, random, bbox kernel", bbox_ns, kernel_ns );
+		report_rates( stats.preferred_direction_interval_count,
+		  stats.preferred_direction_double_double_count,
+		  stats.preferred_direction_exact_count, stats.preferred_direction_total_count );
+	}
+
+	std::cout << "\nside_of_oriented_circle cost on offset inputs "
+	  << "(speedup relative to lifting before translating)\n\n";
+
+	for( double offset : {0.0, 1e6, 1e7, 1e8} ) {
+		auto points = make_offset( engine, 4, offset );
+		Raw_lift_kernel raw_lift_kernel;
+		Raw_lift_kernel::clear_statistics();
+		double raw_ns = ns_per_call( points, 4, [&raw_lift_kernel]( const Point* p ) {
+			return static_cast<int>(raw_lift_kernel.side_of_oriented_circle(
+			  p[0], p[1], p[2], p[3] ));
+		});
+		Interval_exact_kernel::clear_statistics();
+		double translated_ns = ns_per_call( points, 4, [&interval_exact_kernel]( const Point* p ) {
+			return static_cast<int>(interval_exact_kernel.side_of_oriented_circle(
+			  p[0], p[1], p[2], p[3] ));
+		});
+		std::cout << "unit square at offset " << std::scientific << std::setprecision(0)
+		  << offset << std::fixed << '\n';
+		report( "side_of_oriented_circle, lift then translate", raw_ns, raw_ns );
+		report_stages<Raw_lift_kernel>(
+		  &Raw_lift_kernel::Stage_statistics::side_of_oriented_circle_count );
+		report( "side_of_oriented_circle, translate then lift", translated_ns, raw_ns );
+		report_stages<Interval_exact_kernel>(
+		  &Interval_exact_kernel::Stage_statistics::side_of_oriented_circle_count );
+	}
+
+	std::cout << "\nbatched predicate cost on coordinate arrays "
+#if defined(__AVX2__)
+	  << "(AVX2; "
+#else
+	  << "(no AVX2; "
+#endif
+	  << "speedup relative to one call per test)\n\n";
+
+	{
+		constexpr unsigned num_points = 1 << 16;
+		std::uniform_real_distribution<double> coord(0.0, 1.0);
+		std::vector<double> x(num_points);
+		std::vector<double> y(num_points);
+		for( unsigned i = 0; i < num_points; ++i ) {
+			x[i] = coord(engine);
+			y[i] = coord(engine);
+		}
+		auto triples = make_index_groups<3>( engine, num_points );
+		auto quads = make_index_groups<4>( engine, num_points );
+		std::vector<Kernel::Orientation> orientations(num_samples);
+		std::vector<Kernel::Oriented_side> sides(num_samples);
+		auto point = [&]( unsigned i ) { return Point(x[i], y[i]); };
+
+		double scalar_ns = ns_per_call( triples, 1, [&]( const std::array<unsigned, 3>* t ) {
+			return static_cast<int>(bbox_kernel.orientation( point((*t)[0]), point((*t)[1]),
+			  point((*t)[2]) ));
+		});
+		double batch_ns = ns_per_test( num_samples, [&]() {
+			bbox_kernel.orientation_batch( x.data(), y.data(),
+			  reinterpret_cast<const unsigned (*)[3]>(triples.data()), triples.size(),
+			  orientations.data() );
+		});
+		report( "orientation, random, bbox kernel", scalar_ns, scalar_ns );
+		report( "orientation, random, bbox kernel, batched", batch_ns, scalar_ns );
+
+		scalar_ns = ns_per_call( quads, 1, [&]( const std::array<unsigned, 4>* q ) {
+			return static_cast<int>(bbox_kernel.side_of_oriented_circle( point((*q)[0]),
+			  point((*q)[1]), point((*q)[2]), point((*q)[3]) ));
+		});
+		batch_ns = ns_per_test( num_samples, [&]() {
+			bbox_kernel.side_of_oriented_circle_batch( x.data(), y.data(),
+			  reinterpret_cast<const unsigned (*)[4]>(quads.data()), quads.size(),
+			  sides.data() );
+		});
+		report( "side_of_oriented_circle, random, bbox kernel", scalar_ns, scalar_ns );
+		report( "side_of_oriented_circle, random, bbox kernel, batched", batch_ns, scalar_ns );
+	}
+
+	std::cout << "\npredicate cost on float coordinates "
+	  << "(speedup relative to filtering in float)\n\n";
+
+	{
+		Float_kernel float_kernel;
+		Unpromoted_float_kernel unpromoted_kernel;
+		auto random_triples = to_float( make_random( engine, 3 ) );
+		auto grid_triples = to_float( make_grid_triples( engine ) );
+		auto random_quads = to_float( make_random( engine, 4 ) );
+		auto cocircular_quads = to_float( make_cocircular_quads( engine ) );
+		auto orientation = []( auto& k ) {
+			return [&k]( const Float_point* p ) {
+				return static_cast<int>(k.orientation( p[0], p[1], p[2] ));
+			};
+		};
+		auto side_of_oriented_circle = []( auto& k ) {
+			return [&k]( const Float_point* p ) {
+				return static_cast<int>(k.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+			};
+		};
+		for( auto [label, triples] : {std::pair{"random", &random_triples},
+		  std::pair{"grid", &grid_triples}} ) {
+			double float_ns = ns_per_call( *triples, 3, orientation(unpromoted_kernel) );
+			Float_kernel::clear_statistics();
+			double promoted_ns = ns_per_call( *triples, 3, orientation(float_kernel) );
+			std::string name = std::string("orientation, ") + label;
+			report( (name + ", in float").c_str(), float_ns, float_ns );
+			report( (name + ", promoted").c_str(), promoted_ns, float_ns );
+			report_stages<Float_kernel>( &Float_kernel::Stage_statistics::orientation_count );
+		}
+		for( auto [label, quads] : {std::pair{"random", &random_quads},
+		  std::pair{"cocircular", &cocircular_quads}} ) {
+			double float_ns = ns_per_call( *quads, 4, side_of_oriented_circle(unpromoted_kernel) );
+			Float_kernel::clear_statistics();
+			double promoted_ns = ns_per_call( *quads, 4, side_of_oriented_circle(float_kernel) );
+			std::string name = std::string("side_of_oriented_circle, ") + label;
+			report( (name + ", in float").c_str(), float_ns, float_ns );
+			report( (name + ", promoted").c_str(), promoted_ns, float_ns );
+			report_stages<Float_kernel>(
+			  &Float_kernel::Stage_statistics::side_of_oriented_circle_count );
+		}
+	}
+
+	std::cout << "\npredicate cost on integer coordinates "
+	  << "(speedup relative to the same coordinates as double)\n\n";
+
+	{
+		Integer_kernel integer_kernel;
+		auto random_triples = to_grid( make_random( engine, 3 ) );
+		auto grid_triples = to_grid( make_grid_triples( engine ) );
+		auto random_quads = to_grid( make_random( engine, 4 ) );
+		auto cocircular_quads = to_grid( make_cocircular_quads( engine ) );
+		for( auto [label, triples] : {std::pair{"random", &random_triples},
+		  std::pair{"grid", &grid_triples}} ) {
+			double double_ns = ns_per_call( to_double(*triples), 3, [&kernel]( const Point* p ) {
+				return static_cast<int>(kernel.orientation( p[0], p[1], p[2] ));
+			});
+			double integer_ns = ns_per_call( *triples, 3, [&integer_kernel](
+			  const Integer_point* p ) {
+				return static_cast<int>(integer_kernel.orientation( p[0], p[1], p[2] ));
+			});
+			std::string name = std::string("orientation, ") + label;
+			report( (name + ", double kernel").c_str(), double_ns, double_ns );
+			report( (name + ", integer kernel").c_str(), integer_ns, double_ns );
+		}
+		for( auto [label, quads] : {std::pair{"random", &random_quads},
+		  std::pair{"cocircular", &cocircular_quads}} ) {
+			double double_ns = ns_per_call( to_double(*quads), 4, [&kernel]( const Point* p ) {
+				return static_cast<int>(kernel.side_of_oriented_circle( p[0], p[1], p[2], p[3] ));
+			});
+			double integer_ns = ns_per_call( *quads, 4, [&integer_kernel](
+			  const Integer_point* p ) {
+				return static_cast<int>(integer_kernel.side_of_oriented_circle( p[0], p[1],
+				  p[2], p[3] ));
+			});
+			std::string name = std::string("side_of_oriented_circle, ") + label;
+			report( (name + ", double kernel").c_str(), double_ns, double_ns );
+			report( (name + ", integer kernel").c_str(), integer_ns, double_ns );
+		}
+	}
+
+	std::cout << "\nquad classification cost in the flip loop "
+	  << "(speedup relative to separate predicates)\n\n";
+
+	{
+		auto points = make_triangle_pairs( engine );
+		Kernel::Vector u(1, 0);
+		Kernel::Vector v(1, 1);
+		double separate_ns = ns_per_call( points, 4, [&bbox_kernel, &u, &v]( const Point* p ) {
+			return int(!bbox_kernel.is_locally_pd_delaunay_edge( p[2], p[3], p[0], p[1], u, v )
+			  && bbox_kernel.is_strictly_convex_quad( p[0], p[1], p[2], p[3] ));
+		});
+		double classify_ns = ns_per_call( points, 4, [&bbox_kernel, &u, &v]( const Point* p ) {
+			Kernel::Quad_classification quad = bbox_kernel.classify_quad( p[0], p[1], p[2], p[3],
+			  u, v );
+			return int(!quad.locally_pd_delaunay && quad.strictly_convex);
+		});
+		report( "flip test, triangle pairs, separate predicates", separate_ns, separate_ns );
+		report( "flip test, triangle pairs, classify_quad", classify_ns, separate_ns );
+	}
+
+	{
+		auto points = make_cocircular_quads( engine );
+		Kernel::Vector u(1, 0);
+		Kernel::Vector v(1, 1);
+		double separate_ns = ns_per_call( points, 4, [&bbox_kernel, &u, &v]( const Point* p ) {
+			return int(!bbox_kernel.is_locally_pd_delaunay_edge( p[2], p[3], p[0], p[1], u, v )
+			  && bbox_kernel.is_strictly_convex_quad( p[0], p[1], p[2], p[3] ));
+		});
+		double classify_ns = ns_per_call( points, 4, [&bbox_kernel, &u, &v]( const Point* p ) {
+			Kernel::Quad_classification quad = bbox_kernel.classify_quad( p[0], p[1], p[2], p[3],
+			  u, v );
+			return int(!quad.locally_pd_delaunay && quad.strictly_convex);
+		});
+		report( "flip test, cocircular, separate predicates", separate_ns, separate_ns );
+		report( "flip test, cocircular, classify_quad", classify_ns, separate_ns );
+	}
+
+	return 0;
+}
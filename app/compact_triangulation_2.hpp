@@ -0,0 +1,570 @@
+#ifndef compact_triangulation_2_hpp
+#define compact_triangulation_2_hpp
+
+/*
+A triangulation class template with the interface of Triangulation_2 (see
+triangulation_2.hpp), stored in a few contiguous arrays indexed by 32-bit
+integers instead of in CGAL's halfedge data structure, whose vertices,
+halfedges and faces are separately allocated list nodes linked by
+pointers.
+
+The input_off method is no more bulletproof than that of Triangulation_2,
+and reads and checks its input with the same helper functions (see
+triangulation_2.hpp).
+*/
+
+#include "triangulation_2.hpp"
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace trilib {
+
+////////////////////////////////////////////////////////////////////////////////
+// Helper classes for the Compact_triangulation_2 class: the handles.
+// A handle is an index into the arrays of its triangulation, and is also
+// its own iterator (incrementing the index) and the object it refers to
+// (operator-> returns the handle itself), so that it has the interface of
+// the corresponding CGAL handle. Const is true for non-mutating handles.
+// This code is for internal use only and should not be used directly.
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Triangulation, bool Const>
+class Compact_vertex_handle;
+
+template <class Triangulation, bool Const>
+class Compact_halfedge_handle;
+
+template <class Triangulation, bool Const>
+class Compact_face_handle;
+
+template <class Triangulation, bool Const, class Derived>
+class Compact_handle_base
+{
+public:
+	using Owner = std::conditional_t<Const, const Triangulation, Triangulation>;
+	using Index = typename Triangulation::Index;
+
+	Compact_handle_base() : tri_(nullptr), index_(Triangulation::null_index) {}
+	Compact_handle_base(std::nullptr_t) : Compact_handle_base() {}
+	Compact_handle_base(Owner* tri, Index index) : tri_(tri), index_(index) {}
+
+	const Derived* operator->() const
+	  {return static_cast<const Derived*>(this);}
+	const Derived& operator*() const
+	  {return static_cast<const Derived&>(*this);}
+	Derived& operator++()
+	  {++index_; return static_cast<Derived&>(*this);}
+	Derived operator++(int)
+	  {Derived result = static_cast<Derived&>(*this); ++index_; return result;}
+
+	// The position of the referenced item in the arrays of its
+	// triangulation.
+	Index index() const
+	  {return index_;}
+	Owner* triangulation() const
+	  {return tri_;}
+
+	friend bool operator==(const Derived& a, const Derived& b)
+	  {return a.index_ == b.index_;}
+	friend bool operator!=(const Derived& a, const Derived& b)
+	  {return a.index_ != b.index_;}
+	friend bool operator<(const Derived& a, const Derived& b)
+	  {return a.index_ < b.index_;}
+
+protected:
+	Owner* tri_;
+	Index index_;
+};
+
+template <class Triangulation, bool Const>
+class Compact_vertex_handle : public Compact_handle_base<Triangulation,
+  Const, Compact_vertex_handle<Triangulation, Const>>
+{
+	using Base = Compact_handle_base<Triangulation, Const,
+	  Compact_vertex_handle>;
+public:
+	using Point = typename Triangulation::Point;
+	using Point_cache = typename Triangulation::Point_cache;
+	using Base::Base;
+	template <bool C, class = std::enable_if_t<Const && !C>>
+	Compact_vertex_handle(const Compact_vertex_handle<Triangulation, C>& v) :
+	  Base(v.triangulation(), v.index()) {}
+
+	std::conditional_t<Const, const Point&, Point&> point() const
+	  {return this->tri_->points_[this->index_];}
+	Compact_halfedge_handle<Triangulation, Const> halfedge() const
+	  {return {this->tri_, this->tri_->vertex_halfedges_[this->index_]};}
+	template <class K = typename Triangulation::Kernel,
+	  class = typename K::Point_cache>
+	Point_cache& point_cache() const
+	  {return this->tri_->point_caches_[this->index_];}
+	std::size_t id() const
+	  {return this->index_;}
+};
+
+template <class Triangulation, bool Const>
+class Compact_halfedge_handle : public Compact_handle_base<Triangulation,
+  Const, Compact_halfedge_handle<Triangulation, Const>>
+{
+	using Base = Compact_handle_base<Triangulation, Const,
+	  Compact_halfedge_handle>;
+public:
+	using Base::Base;
+	template <bool C, class = std::enable_if_t<Const && !C>>
+	Compact_halfedge_handle(const Compact_halfedge_handle<Triangulation, C>& h) :
+	  Base(h.triangulation(), h.index()) {}
+
+	// The opposite halfedge is the other one of its pair.
+	Compact_halfedge_handle opposite() const
+	  {return {this->tri_, this->index_ ^ 1};}
+	Compact_halfedge_handle next() const
+	  {return {this->tri_, record().next};}
+	Compact_halfedge_handle prev() const
+	  {return {this->tri_, record().prev};}
+	Compact_vertex_handle<Triangulation, Const> vertex() const
+	  {return {this->tri_, record().vertex};}
+	Compact_face_handle<Triangulation, Const> face() const
+	  {return {this->tri_, record().face};}
+	Compact_face_handle<Triangulation, Const> facet() const
+	  {return face();}
+	bool is_border() const
+	  {return record().face == Triangulation::null_index;}
+	bool is_border_edge() const
+	  {return is_border() || opposite()->is_border();}
+	Compact_halfedge_handle edge() const
+	  {return {this->tri_, this->index_ & ~typename Base::Index(1)};}
+	bool is_triangle() const
+	{
+		return next() != *this && next()->next() != *this &&
+		  next()->next()->next() == *this;
+	}
+	void set_next(Compact_halfedge_handle h) const
+	  {this->tri_->halfedges_[this->index_].next = h.index();}
+	void set_prev(Compact_halfedge_handle h) const
+	  {this->tri_->halfedges_[this->index_].prev = h.index();}
+
+private:
+	const typename Triangulation::Halfedge_record& record() const
+	  {return this->tri_->halfedges_[this->index_];}
+};
+
+template <class Triangulation, bool Const>
+class Compact_face_handle : public Compact_handle_base<Triangulation,
+  Const, Compact_face_handle<Triangulation, Const>>
+{
+	using Base = Compact_handle_base<Triangulation, Const,
+	  Compact_face_handle>;
+public:
+	using Base::Base;
+	template <bool C, class = std::enable_if_t<Const && !C>>
+	Compact_face_handle(const Compact_face_handle<Triangulation, C>& f) :
+	  Base(f.triangulation(), f.index()) {}
+
+	Compact_halfedge_handle<Triangulation, Const> halfedge() const
+	  {return {this->tri_, this->tri_->face_halfedges_[this->index_]};}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// The Compact_triangulation_2 class template.
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+The halfedges are stored in one array, in pairs: halfedge h is opposite
+halfedge h ^ 1, so that opposite needs no storage or memory access, and
+each holds only the indices of its next and previous halfedges, its vertex
+and its face. The vertex data is split into parallel arrays of points,
+point caches (see Kernel::Point_cache) and incident halfedges, so that a
+predicate reads only the points and caches; a vertex's id is its index,
+which is also its index in the input. A face is the index of one of its
+halfedges.
+
+The points are kept whole rather than as separate arrays of x and y
+coordinates: a vertex handle's point() returns a reference to a Point,
+which is what the kernel's predicates take, and a Point may be a
+reference-counted handle (as with CGAL::Cartesian) that would be costly to
+rebuild from its coordinates on each access. The predicates also read
+both coordinates of each point together, so a Point of plain coordinates
+(as with CGAL::Simple_cartesian) already puts them in the same cache line,
+where separate arrays would take two. The checks that test every face at
+once (see check_triangulation) copy the coordinates into separate arrays
+for the batched predicates.
+
+For a triangulation with n vertices, this takes about a third of the memory
+of Triangulation_2, and following next, opposite and vertex reads
+neighbouring array elements rather than separate heap nodes.
+
+Template parameters:
+K    The geometry kernel to be used by the triangulation
+     (e.g., ra::geometry::Kernel<CGAL::Simple_cartesian<double>>).
+*/
+
+template <typename K>
+class Compact_triangulation_2 {
+public:
+
+	// The geometry kernel used by the class.
+	using Kernel = K;
+
+	// The point (in 2-D) type.
+	using Point = typename Kernel::Point_2;
+
+	// The data kept for each vertex by the kernel's predicates, if any.
+	using Point_cache = typename Vertex_cache<Kernel>::type;
+
+	// The type of the indices of vertices, halfedges and faces, and the
+	// index of no item (e.g., the face of a border halfedge).
+	using Index = std::uint32_t;
+	static constexpr Index null_index = std::numeric_limits<Index>::max();
+
+	// The handle and iterator types, with the interfaces of those of
+	// Triangulation_2 (point, halfedge and id for vertices; opposite, next,
+	// prev, vertex, face, facet, is_border, is_border_edge, edge and
+	// is_triangle for halfedges; and halfedge for faces). A handle is also
+	// the object it refers to, so that h->next() and (*h).next() are the
+	// same; there are no separate vertex, halfedge or face objects.
+	using Vertex_handle = Compact_vertex_handle<Compact_triangulation_2, false>;
+	using Vertex_const_handle = Compact_vertex_handle<Compact_triangulation_2, true>;
+	using Vertex_iterator = Vertex_handle;
+	using Vertex_const_iterator = Vertex_const_handle;
+	using Face_handle = Compact_face_handle<Compact_triangulation_2, false>;
+	using Face_const_handle = Compact_face_handle<Compact_triangulation_2, true>;
+	using Face_iterator = Face_handle;
+	using Face_const_iterator = Face_const_handle;
+	using Halfedge_handle = Compact_halfedge_handle<Compact_triangulation_2, false>;
+	using Halfedge_const_handle = Compact_halfedge_handle<Compact_triangulation_2, true>;
+	using Halfedge_iterator = Halfedge_handle;
+	using Halfedge_const_iterator = Halfedge_const_handle;
+
+	/*
+	As for Triangulation_2, a halfedge and its opposite halfedge always
+	appear consecutively in the iteration order.
+	*/
+
+	/*
+	Construct a triangulation from an input stream in OFF format, as for
+	Triangulation_2.
+	*/
+	Compact_triangulation_2(std::istream& in, double quantum = 0);
+
+	// The triangulation type is not movable.
+	Compact_triangulation_2(Compact_triangulation_2&&) = delete;
+	Compact_triangulation_2& operator=(Compact_triangulation_2&&) = delete;
+
+	// The triangulation type is not copyable.
+	Compact_triangulation_2(const Compact_triangulation_2&) = delete;
+	Compact_triangulation_2& operator=(const Compact_triangulation_2&) = delete;
+
+	int size_of_vertices() const
+	  {return points_.size();}
+	int size_of_faces() const
+	  {return face_halfedges_.size();}
+	int size_of_halfedges() const
+	  {return halfedges_.size();}
+	int size_of_edges() const
+	  {return halfedges_.size() / 2;}
+
+	double max_abs_coordinate() const
+	  {return max_abs_coordinate_;}
+	double quantum() const
+	  {return quantum_;}
+
+	Vertex_iterator vertices_begin()
+	  {return {this, 0};}
+	Vertex_const_iterator vertices_begin() const
+	  {return {this, 0};}
+	Vertex_iterator vertices_end()
+	  {return {this, Index(points_.size())};}
+	Vertex_const_iterator vertices_end() const
+	  {return {this, Index(points_.size())};}
+
+	Face_iterator faces_begin()
+	  {return {this, 0};}
+	Face_const_iterator faces_begin() const
+	  {return {this, 0};}
+	Face_iterator faces_end()
+	  {return {this, Index(face_halfedges_.size())};}
+	Face_const_iterator faces_end() const
+	  {return {this, Index(face_halfedges_.size())};}
+
+	Halfedge_iterator halfedges_begin()
+	  {return {this, 0};}
+	Halfedge_const_iterator halfedges_begin() const
+	  {return {this, 0};}
+	Halfedge_iterator halfedges_end()
+	  {return {this, Index(halfedges_.size())};}
+	Halfedge_const_iterator halfedges_end() const
+	  {return {this, Index(halfedges_.size())};}
+
+	/*
+	Perform an edge flip, as for Triangulation_2 (the halfedges, vertices and
+	faces are relinked exactly as CGAL's HalfedgeDS_items_decorator does).
+	*/
+	Halfedge_handle flip_edge(Halfedge_handle h);
+
+	/*
+	Read or write a triangulation in OFF format, as for Triangulation_2.
+	*/
+	bool input_off(std::istream& in, double quantum = 0);
+	bool output_off(std::ostream& out) const;
+
+private:
+
+	template <class, bool> friend class Compact_vertex_handle;
+	template <class, bool> friend class Compact_halfedge_handle;
+	template <class, bool> friend class Compact_face_handle;
+
+	struct Halfedge_record
+	{
+		Index next;
+		Index prev;
+		Index vertex;
+		Index face;
+	};
+
+	void clear();
+	Index lookup_halfedge(Index va, Index vb,
+	  std::unordered_map<std::uint64_t, Index>& edge_lut);
+	bool add_face(Index va, Index vb, Index vc,
+	  std::unordered_map<std::uint64_t, Index>& edge_lut);
+	bool check();
+
+	std::vector<Halfedge_record> halfedges_;
+	std::vector<Point> points_;
+	mutable std::vector<Point_cache> point_caches_;
+	std::vector<Index> vertex_halfedges_;
+	std::vector<Index> face_halfedges_;
+	double max_abs_coordinate_;
+	double quantum_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code for Compact_triangulation_2 class.
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Kernel>
+Compact_triangulation_2<Kernel>::Compact_triangulation_2(std::istream& in,
+  double quantum)
+{
+	clear();
+	if (!input_off(in, quantum)) {
+		throw std::exception();
+	}
+}
+
+template <typename Kernel>
+void Compact_triangulation_2<Kernel>::clear()
+{
+	halfedges_.clear();
+	points_.clear();
+	point_caches_.clear();
+	vertex_halfedges_.clear();
+	face_halfedges_.clear();
+	max_abs_coordinate_ = 0;
+	quantum_ = 0;
+}
+
+template <typename Kernel>
+auto Compact_triangulation_2<Kernel>::lookup_halfedge(Index va, Index vb,
+  std::unordered_map<std::uint64_t, Index>& edge_lut) -> Index
+{
+	std::uint64_t key = (std::uint64_t(std::min(va, vb)) << 32) |
+	  std::max(va, vb);
+	auto i = edge_lut.find(key);
+	if (i == edge_lut.end()) {
+		Index result = halfedges_.size();
+		halfedges_.push_back({null_index, null_index, vb, null_index});
+		halfedges_.push_back({null_index, null_index, va, null_index});
+		edge_lut.insert({key, result});
+		if (vertex_halfedges_[vb] == null_index) {
+			vertex_halfedges_[vb] = result;
+		}
+		if (vertex_halfedges_[va] == null_index) {
+			vertex_halfedges_[va] = result ^ 1;
+		}
+		return result;
+	}
+	Index result = i->second;
+	if (halfedges_[result].vertex == va) {
+		result ^= 1;
+	}
+	assert(halfedges_[result].vertex == vb);
+	return result;
+}
+
+template <typename Kernel>
+bool Compact_triangulation_2<Kernel>::add_face(Index va, Index vb, Index vc,
+  std::unordered_map<std::uint64_t, Index>& edge_lut)
+{
+	assert(is_left_turn<Kernel>(points_[va], points_[vb], points_[vc]));
+	Index ab = lookup_halfedge(va, vb, edge_lut);
+	Index bc = lookup_halfedge(vb, vc, edge_lut);
+	Index ca = lookup_halfedge(vc, va, edge_lut);
+	if (halfedges_[ab].face != null_index || halfedges_[bc].face != null_index ||
+	  halfedges_[ca].face != null_index) {
+		// ERROR
+		assert(false);
+		abort();
+	}
+	Index face = face_halfedges_.size();
+	face_halfedges_.push_back(ab);
+	halfedges_[ab] = {bc, ca, vb, face};
+	halfedges_[bc] = {ca, ab, vc, face};
+	halfedges_[ca] = {ab, bc, va, face};
+	return true;
+}
+
+template <typename Kernel>
+bool Compact_triangulation_2<Kernel>::check()
+{
+	// The border halfedges are linked into a loop starting from the first.
+	Index num_border = 0;
+	Index border_halfedge = null_index;
+	for (Index h = 0; h < halfedges_.size(); ++h) {
+		if (halfedges_[h].face == null_index) {
+			++num_border;
+			border_halfedge = std::min(border_halfedge, h);
+		}
+	}
+	return check_triangulation<Kernel>(*this,
+	  Halfedge_handle(this, border_halfedge), num_border);
+}
+
+template <typename Kernel>
+bool Compact_triangulation_2<Kernel>::input_off(std::istream& in,
+  double quantum)
+{
+	clear();
+	std::vector<std::array<int, 3>> faces;
+	double max_abs_coordinate;
+	if (!read_off<Kernel>(in, quantum, points_, faces, max_abs_coordinate)) {
+		clear();
+		return false;
+	}
+	// Every vertex and halfedge (at most six per face, counting the
+	// opposites) must have a 32-bit index
+	if (points_.size() >= null_index || faces.size() >= null_index / 6) {
+		std::cerr << "too many vertices/faces\n";
+		clear();
+		return false;
+	}
+	Index num_vertices = points_.size();
+	Index num_faces = faces.size();
+	point_caches_.resize(num_vertices);
+	vertex_halfedges_.assign(num_vertices, null_index);
+	face_halfedges_.reserve(num_faces);
+	halfedges_.reserve(3 * std::size_t(num_faces) + 6);
+	std::unordered_map<std::uint64_t, Index> edge_lut;
+	edge_lut.reserve(2 * std::size_t(num_faces) + 3);
+	for (const std::array<int, 3>& vi : faces) {
+		add_face(vi[0], vi[1], vi[2], edge_lut);
+	}
+	if (!check()) {
+		clear();
+		return false;
+	}
+	halfedges_.shrink_to_fit();
+	max_abs_coordinate_ = max_abs_coordinate;
+	quantum_ = quantum;
+	return true;
+}
+
+template <typename Kernel>
+bool Compact_triangulation_2<Kernel>::output_off(std::ostream& out) const
+{
+	out << "OFF\n";
+	out << points_.size() << " " << face_halfedges_.size() << " "
+	  << 0 << "\n";
+	for (const Point& p : points_) {
+		if (quantum_ != 0) {
+			out << p.x() * quantum_ << " " << p.y() * quantum_ << " 0\n";
+		} else {
+			out << p.x() << " " << p.y() << " 0\n";
+		}
+	}
+	for (Index h : face_halfedges_) {
+		Index v0 = halfedges_[h].vertex;
+		h = halfedges_[h].next;
+		Index v1 = halfedges_[h].vertex;
+		h = halfedges_[h].next;
+		Index v2 = halfedges_[h].vertex;
+		out << "3 " << v0 << " " << v1 << " " << v2 << "\n";
+	}
+	return bool(out);
+}
+
+template <typename Kernel>
+auto Compact_triangulation_2<Kernel>::flip_edge(Halfedge_handle h)
+  -> Halfedge_handle
+{
+	// The edge ab, with faces abc (h from a to b) and bad (g = h ^ 1),
+	// becomes the edge dc, with faces cad and dbc
+	Index hi = h.index();
+	Index gi = hi ^ 1;
+	Index h1 = halfedges_[hi].next;
+	Index h2 = halfedges_[h1].next;
+	Index g1 = halfedges_[gi].next;
+	Index g2 = halfedges_[g1].next;
+	assert(halfedges_[h2].next == hi && halfedges_[g2].next == gi);
+	Index f1 = halfedges_[hi].face;
+	Index f2 = halfedges_[gi].face;
+	Index a = halfedges_[gi].vertex;
+	Index b = halfedges_[hi].vertex;
+	halfedges_[hi] = {h2, g1, halfedges_[h1].vertex, f1};
+	halfedges_[gi] = {g2, h1, halfedges_[g1].vertex, f2};
+	halfedges_[h2].next = g1;
+	halfedges_[h2].prev = hi;
+	halfedges_[g1] = {hi, h2, halfedges_[g1].vertex, f1};
+	halfedges_[g2].next = h1;
+	halfedges_[g2].prev = gi;
+	halfedges_[h1] = {gi, g2, halfedges_[h1].vertex, f2};
+	face_halfedges_[f1] = h2;
+	face_halfedges_[f2] = g2;
+	vertex_halfedges_[a] = h2;
+	vertex_halfedges_[b] = g2;
+	return h;
+}
+
+}
+
+namespace std {
+
+template <class Triangulation, bool Const>
+struct hash<trilib::Compact_vertex_handle<Triangulation, Const>>
+{
+	std::size_t operator()(
+	  const trilib::Compact_vertex_handle<Triangulation, Const>& v) const
+	  {return std::hash<typename Triangulation::Index>()(v.index());}
+};
+
+template <class Triangulation, bool Const>
+struct hash<trilib::Compact_halfedge_handle<Triangulation, Const>>
+{
+	std::size_t operator()(
+	  const trilib::Compact_halfedge_handle<Triangulation, Const>& h) const
+	  {return std::hash<typename Triangulation::Index>()(h.index());}
+};
+
+template <class Triangulation, bool Const>
+struct hash<trilib::Compact_face_handle<Triangulation, Const>>
+{
+	std::size_t operator()(
+	  const trilib::Compact_face_handle<Triangulation, Const>& f) const
+	  {return std::hash<typename Triangulation::Index>()(f.index());}
+};
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef delaunay_hpp
+#define delaunay_hpp
+
+#include <cstddef>
+#include <queue>
+#include <unordered_set>
+
+// Make a triangulation preferred-directions Delaunay with Lawson's
+// edge-flip algorithm, preferring the directions u = (1, 0) and
+// v = (1, 1), and return the number of edges flipped. If perturb is
+// true, ties among cocircular points are instead broken by symbolic
+// perturbation of the vertices in the order of their ids (see
+// Kernel::side_of_oriented_circle_perturbed); the result is then
+// Delaunay but not in general preferred-directions Delaunay. If
+// cache_bits is nonzero, the kernel keeps a predicate cache of
+// 2^cache_bits entries (see Kernel::enable_predicate_cache) for the
+// quadrilaterals that are classified again after a nearby flip. The
+// triangulation is a trilib::Triangulation_2 or a
+// trilib::Compact_triangulation_2.
+template <class Triangulation>
+std::size_t make_delaunay(Triangulation& trangle,
+  bool perturb = false, unsigned cache_bits = 0) {
+	using Kernel = typename Triangulation::Kernel;
+	using Halfedge = typename Triangulation::Halfedge_handle;
+
+	Kernel predicator;
+	std::size_t num_flips = 0;
+
+	// Derive the kernel's error bounds from the bounding box of the
+	// input; the preferred directions below have unit components
+	predicator.configure_for_bbox(trangle.max_abs_coordinate(), 1);
+	predicator.enable_predicate_cache(cache_bits);
+	
+	// Set to containly edges who are currently optimal but
+	// whose optimality status is subject to change
+	std::unordered_set<Halfedge> optimals {};
+
+	// Queue to contain suspect edges
+	std::queue<Halfedge> sus {};
+
+	// Iterate over all halfedges in the triangulation.
+	// Test if halfedge corresponds to a border edge; if
+	// so, do nothing at border edges are permanently
+	// optimal. Otherwise, test if edge is a strictly convex
+	// quadrilateral; if not, place into sus queue, otherwise
+	// place into optimals set.
+	for(auto iter = trangle.halfedges_begin(); iter != trangle.halfedges_end(); ++iter){
+		Halfedge h = iter;
+		if( !(h->is_border_edge()) ){
+			if( predicator.is_strictly_convex_quad(
+					h->vertex()->point(),
+					h->next()->vertex()->point(),
+					h->opposite()->vertex()->point(),
+					h->opposite()->next()->vertex()->point()) ) {
+				sus.push(h);
+			}else{
+				optimals.insert(h);
+			}
+		}
+	}
+
+	// Ensure all edges are either fully in or fully out of
+	// optimals set, i.e. no cases where one halfedge is in
+	// and another is out.
+	for( auto ha : optimals )
+		if( optimals.find(ha->opposite()) != optimals.end() )
+			optimals.insert( ha->opposite() );
+
+	// Create vectors for preferred directions delaunay test
+	typename Kernel::Vector u(1,0);
+	typename Kernel::Vector v(1,1);
+
+	// Iterate over sus queue until empty.
+	while( !sus.empty() ) {
+		// Test the edge; the perturbed test and the predicate cache
+		// classify the quadrilateral around it in one call.
+		Halfedge h = sus.front();
+		bool flip;
+		if( perturb ){
+			typename Kernel::Quad_classification quad =
+				predicator.classify_quad_perturbed(
+					h->vertex(),
+					h->next()->vertex(),
+					h->opposite()->vertex(),
+					h->opposite()->next()->vertex() );
+			flip = !quad.locally_pd_delaunay && quad.strictly_convex;
+		}else if( cache_bits != 0 ){
+			typename Kernel::Quad_classification quad =
+				predicator.classify_quad(
+					h->vertex(),
+					h->next()->vertex(),
+					h->opposite()->vertex(),
+					h->opposite()->next()->vertex(),
+					u,
+					v );
+			flip = !quad.locally_pd_delaunay && quad.strictly_convex;
+		}else{
+			flip = !predicator.is_locally_pd_delaunay_edge(
+					h->opposite()->vertex()->point(),
+					h->opposite()->next()->vertex()->point(),
+					h->vertex()->point(),
+					h->next()->vertex()->point(),
+					u,
+					v )
+			 && predicator.is_strictly_convex_quad(
+					h->vertex()->point(),
+					h->next()->vertex()->point(),
+					h->opposite()->vertex()->point(),
+					h->opposite()->next()->vertex()->point() );
+		}
+		if( flip ) {
+			// If edge fails locally preferred delaunay test
+			// and is part of a strictly convex quadrilateral,
+			// then flip edge and place edge in optimals set.
+			trangle.flip_edge(sus.front());
+			++num_flips;
+			optimals.insert(sus.front());
+			optimals.insert(sus.front()->opposite());
+
+			// Place previously optimal edges that might have been
+			// affected by the edge flip into the sus queue.
+			if( optimals.find(sus.front()->next()) != optimals.end() ){
+				sus.push(*optimals.find(sus.front()->next()));
+				sus.push(*optimals.find(sus.front()->next()->opposite()));
+				optimals.erase(optimals.find(sus.front()->next()));
+				optimals.erase(optimals.find(sus.front()->next()->opposite()));
+			}
+
+			if( optimals.find(sus.front()->prev()) != optimals.end() ){
+				sus.push(*optimals.find(sus.front()->prev()));
+				sus.push(*optimals.find(sus.front()->prev()->opposite()));
+				optimals.erase(optimals.find(sus.front()->prev()));
+				optimals.erase(optimals.find(sus.front()->prev()->opposite()));
+			}
+
+			if( optimals.find(sus.front()->opposite()->next()) != optimals.end() ){
+				sus.push(*optimals.find(sus.front()->opposite()->next()));
+				sus.push(*optimals.find(sus.front()->opposite()->next()->opposite()));
+				optimals.erase(optimals.find(sus.front()->opposite()->next()));
+				optimals.erase(optimals.find(sus.front()->opposite()->next()->opposite()));
+			}
+
+			if( optimals.find(sus.front()->opposite()->prev()) != optimals.end() ){
+				sus.push(*optimals.find(sus.front()->opposite()->prev()));
+				sus.push(*optimals.find(sus.front()->opposite()->prev()->opposite()));
+				optimals.erase(optimals.find(sus.front()->opposite()->prev()));
+				optimals.erase(optimals.find(sus.front()->opposite()->prev()->opposite()));
+			}
+		}else{
+			// If edge satisfies preferred directions delaunay test
+			// then mark it as optimal.
+			optimals.insert( sus.front() );
+			optimals.insert( sus.front()->opposite() );
+			sus.pop();
+		}
+	}
+
+	return num_flips;
+}
+
+#endif
@@ -0,0 +1,769 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include "ra/bigfloat.hpp"
+#include "ra/double_double.hpp"
+#include "ra/exact_predicates.hpp"
+#include "ra/filters.hpp"
+#include "ra/interval.hpp"
+#include "ra/kernel.hpp"
+#include <CGAL/MP_Float.h>
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using Reference = ra::geometry::number_type_exact<CGAL::MP_Float>;
+using Expansion = ra::geometry::expansion_exact<Reference>;
+using Bigfloat = ra::math::bigfloat<18>;
+using Bounded = ra::geometry::bounded_number_type_exact<Bigfloat, Reference>;
+
+namespace {
+
+// Coordinates whose differences are mostly inexact, so that the tails of
+// the differences matter; shifted near points are nearly degenerate.
+struct point_source {
+	std::mt19937_64 engine {2024};
+	std::uniform_real_distribution<double> unit {-1.0, 1.0};
+	std::uniform_int_distribution<int> ulps {-4, 4};
+
+	double coordinate( double scale ) { return unit(engine) * scale; }
+
+	// x moved by a few units in the last place.
+	double perturb( double x ) {
+		for( int i = ulps(engine); i != 0; i += (i > 0) ? -1 : 1 ) {
+			x = std::nextafter(x, (i > 0) ? 2.0 * x + 1.0 : 2.0 * x - 1.0);
+		}
+		return x;
+	}
+};
+
+}
+
+TEST_CASE("Check expansion orientation against MP_Float", "[exact]") {
+	point_source s;
+	for( double scale : {1.0, 1e-30, 1e30, 1e200} ) {
+		for( int i = 0; i < 2000; ++i ) {
+			double ax = s.coordinate(scale) + 3.0 * scale;
+			double ay = s.coordinate(scale);
+			double bx = s.coordinate(scale) + 3.0 * scale;
+			double by = s.coordinate(scale);
+			// Nearly on the line through a and b
+			double cx = s.perturb( 2.0 * bx - ax );
+			double cy = s.perturb( 2.0 * by - ay );
+			CHECK( Expansion::orientation(ax, ay, bx, by, cx, cy)
+			  == Reference::orientation(ax, ay, bx, by, cx, cy) );
+		}
+	}
+}
+
+TEST_CASE("Check expansion side_of_oriented_circle against MP_Float", "[exact]") {
+	point_source s;
+	for( double scale : {1.0, 1e-30, 1e30, 1e200} ) {
+		for( int i = 0; i < 2000; ++i ) {
+			// Nearly cocircular: perturbed corners of a rectangle
+			double x = s.coordinate(scale) + 3.0 * scale;
+			double y = s.coordinate(scale);
+			double x2 = x + std::abs(s.coordinate(scale));
+			double y2 = y + std::abs(s.coordinate(scale));
+			double ax = s.perturb(x);
+			double ay = y;
+			double bx = x2;
+			double by = s.perturb(y);
+			double cx = s.perturb(x2);
+			double cy = s.perturb(y2);
+			double dx = x;
+			double dy = s.perturb(y2);
+			CHECK( Expansion::side_of_oriented_circle(ax, ay, bx, by, cx, cy, dx, dy)
+			  == Reference::side_of_oriented_circle(ax, ay, bx, by, cx, cy, dx, dy) );
+		}
+	}
+}
+
+TEST_CASE("Check expansion preferred_direction against MP_Float", "[exact]") {
+	point_source s;
+	for( double scale : {1.0, 1e-30, 1e30, 1e200} ) {
+		for( int i = 0; i < 2000; ++i ) {
+			// Segments ab and cd of nearly equal length and angle to v
+			double ax = s.coordinate(scale) + 3.0 * scale;
+			double ay = s.coordinate(scale);
+			double bx = s.coordinate(scale) + 3.0 * scale;
+			double by = s.coordinate(scale);
+			double cx = s.coordinate(scale) - 3.0 * scale;
+			double cy = s.coordinate(scale);
+			double dx = s.perturb( cx + (by - ay) );
+			double dy = s.perturb( cy + (bx - ax) );
+			double vx = (i % 2) ? 1.0 : s.coordinate(1.0);
+			double vy = (i % 3) ? 1.0 : s.coordinate(1.0);
+			CHECK( Expansion::preferred_direction(ax, ay, bx, by, cx, cy, dx, dy, vx, vy)
+			  == Reference::preferred_direction(ax, ay, bx, by, cx, cy, dx, dy, vx, vy) );
+		}
+	}
+}
+
+TEST_CASE("Check expansion predicates on exact degeneracies", "[exact]") {
+	CHECK( Expansion::orientation(0.1, 0.2, 0.3, 0.4, 0.5, 0.6)
+	  == Reference::orientation(0.1, 0.2, 0.3, 0.4, 0.5, 0.6) );
+	CHECK( Expansion::orientation(1.0, 1.0, 2.0, 2.0, 3.0, 3.0) == 0 );
+	CHECK( Expansion::side_of_oriented_circle(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0) == 0 );
+	CHECK( Expansion::side_of_oriented_circle(0.1, 0.1, 0.7, 0.1, 0.7, 0.3, 0.1, 0.3) == 0 );
+	CHECK( Expansion::preferred_direction(0.0, 0.0, 1.0, 1.0, 5.0, 5.0, 6.0, 6.0, 1.0, 0.0) == 0 );
+}
+
+TEST_CASE("Check expansion predicates do not depend on the rounding mode", "[exact]") {
+	point_source s;
+	for( int mode : {FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO} ) {
+		for( int i = 0; i < 500; ++i ) {
+			double ax = s.coordinate(1.0);
+			double ay = s.coordinate(1.0);
+			double bx = s.coordinate(1.0);
+			double by = s.coordinate(1.0);
+			double cx = s.perturb( 2.0 * bx - ax );
+			double cy = s.perturb( 2.0 * by - ay );
+			int expected = Reference::orientation(ax, ay, bx, by, cx, cy);
+			std::fesetround(mode);
+			int result = Expansion::orientation(ax, ay, bx, by, cx, cy);
+			bool restored = std::fegetround() == mode;
+			std::fesetround(FE_TONEAREST);
+			CHECK( result == expected );
+			CHECK( restored );
+		}
+	}
+}
+
+TEST_CASE("Check expansion predicates out of range", "[exact]") {
+	// Handled by the fallback
+	double tiny = 1e-300;
+	double huge = 1e300;
+	CHECK( Expansion::orientation(0.0, 0.0, tiny, tiny, 2.0 * tiny, 2.0 * tiny) == 0 );
+	CHECK( Expansion::orientation(0.0, 0.0, tiny, 0.0, 0.0, tiny) == 1 );
+	CHECK( Expansion::orientation(0.0, 0.0, huge, 0.0, 0.0, huge) == 1 );
+	CHECK( Expansion::side_of_oriented_circle(huge, 0.0, 0.0, huge, -huge, 0.0, 0.0, -huge) == 0 );
+	CHECK( Expansion::side_of_oriented_circle(tiny, 0.0, 0.0, tiny, -tiny, 0.0, 0.0, -tiny / 2.0) == 1 );
+}
+
+TEST_CASE("Check integer predicates against MP_Float", "[exact]") {
+	// Coordinates over the whole 32-bit range, near its ends, and on small
+	// lattices (with many exact degeneracies); the side-of-oriented-circle
+	// determinant then needs more than 128 bits
+	using Integer = ra::geometry::integer_exact<Expansion>;
+	constexpr std::int32_t max = std::numeric_limits<std::int32_t>::max();
+	constexpr std::int32_t min = std::numeric_limits<std::int32_t>::min();
+	std::mt19937_64 engine {2024};
+	std::uniform_int_distribution<std::int32_t> full {min, max};
+	std::uniform_int_distribution<std::int32_t> small {-3, 3};
+	for( int i = 0; i < 30000; ++i ) {
+		std::int32_t c[10];
+		for( std::int32_t& x : c ) {
+			switch( i % 3 ) {
+			case 0:
+				x = full(engine);
+				break;
+			case 1:
+				x = (small(engine) < 0) ? min - small(engine) + 3 : max - small(engine) - 3;
+				break;
+			default:
+				x = small(engine);
+				break;
+			}
+		}
+		CHECK( Integer::orientation(c[0], c[1], c[2], c[3], c[4], c[5])
+		  == Reference::orientation(c[0], c[1], c[2], c[3], c[4], c[5]) );
+		CHECK( Integer::side_of_oriented_circle(c[0], c[1], c[2], c[3], c[4], c[5], c[6],
+		  c[7]) == Reference::side_of_oriented_circle(c[0], c[1], c[2], c[3], c[4], c[5],
+		  c[6], c[7]) );
+		CHECK( Integer::preferred_direction(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7],
+		  c[8], c[9]) == Reference::preferred_direction(c[0], c[1], c[2], c[3], c[4], c[5],
+		  c[6], c[7], c[8], c[9]) );
+	}
+	// The largest determinants, with the corners of the range
+	CHECK( Integer::side_of_oriented_circle(max, min, max, max, min, max, min, min) == 0 );
+	CHECK( Integer::side_of_oriented_circle(max, min, max, max, min, max, min, min + 1)
+	  == Reference::side_of_oriented_circle(max, min, max, max, min, max, min, min + 1) );
+	CHECK( Integer::side_of_oriented_circle(max, min, max, max, min, max, 0, 0) == 1 );
+	CHECK( Integer::orientation(min, min, max, max, min, max) == 1 );
+}
+
+TEST_CASE("Check bigfloat arithmetic", "[bigfloat]") {
+	std::mt19937_64 engine {7};
+	std::uniform_real_distribution<double> unit {-1.0, 1.0};
+	std::uniform_int_distribution<int> exponent {-60, 60};
+	auto number = [&]() { return std::ldexp(unit(engine), exponent(engine)); };
+	for( int i = 0; i < 5000; ++i ) {
+		double a = number();
+		double b = number();
+		double c = number();
+		double d = number();
+		Bigfloat x = (Bigfloat(a) * Bigfloat(b)) - (Bigfloat(c) * Bigfloat(d)) + Bigfloat(a);
+		CGAL::MP_Float y = (CGAL::MP_Float(a) * CGAL::MP_Float(b))
+		  - (CGAL::MP_Float(c) * CGAL::MP_Float(d)) + CGAL::MP_Float(a);
+		CHECK( !x.overflow() );
+		CHECK( x.sign() == ra::geometry::sign_of(y) );
+		// Exact cancellation
+		Bigfloat z = ((Bigfloat(a) + Bigfloat(b)) * Bigfloat(c)) - (Bigfloat(a) * Bigfloat(c))
+		  - (Bigfloat(b) * Bigfloat(c));
+		CHECK( z.sign() == 0 );
+	}
+	CHECK( Bigfloat(0).sign() == 0 );
+	CHECK( Bigfloat(-0.0).sign() == 0 );
+	CHECK( Bigfloat(5e-324).sign() == 1 );
+	CHECK( (-Bigfloat(2.5)).sign() == -1 );
+	CHECK( Bigfloat(1.0) < Bigfloat(1.0) + Bigfloat(1e-300) );
+	CHECK( !(Bigfloat(1e300) < Bigfloat(-1e300)) );
+}
+
+TEST_CASE("Check bigfloat overflow", "[bigfloat]") {
+	using Small = ra::math::bigfloat<2>;
+	Small sum = Small(1e100) + Small(1e-100);
+	CHECK( sum.overflow() );
+	CHECK( (sum * Small(0)).overflow() );
+	CHECK( !(Small(1e100) * Small(1e-100)).overflow() );
+	CHECK( (Small(1.0 / 3.0) * Small(1.0 / 3.0) * Small(1.0 / 3.0)).overflow() );
+	CHECK( Small(std::numeric_limits<double>::infinity()).overflow() );
+}
+
+TEST_CASE("Check bigfloat predicates against MP_Float", "[bigfloat]") {
+	point_source s;
+	for( double scale : {1.0, 1e-300, 1e300} ) {
+		for( int i = 0; i < 1000; ++i ) {
+			double ax = s.coordinate(scale);
+			double ay = s.coordinate(scale);
+			double bx = s.coordinate(scale);
+			double by = s.coordinate(scale);
+			double cx = s.perturb( 2.0 * bx - ax );
+			double cy = s.perturb( 2.0 * by - ay );
+			double dx = s.perturb( ax + cx - bx );
+			double dy = s.perturb( ay + cy - by );
+			CHECK( Bounded::orientation(ax, ay, bx, by, cx, cy)
+			  == Reference::orientation(ax, ay, bx, by, cx, cy) );
+			CHECK( Bounded::side_of_oriented_circle(ax, ay, bx, by, cx, cy, dx, dy)
+			  == Reference::side_of_oriented_circle(ax, ay, bx, by, cx, cy, dx, dy) );
+			CHECK( Bounded::preferred_direction(ax, ay, bx, by, cx, cy, dx, dy, 1.0, 1.0)
+			  == Reference::preferred_direction(ax, ay, bx, by, cx, cy, dx, dy, 1.0, 1.0) );
+		}
+	}
+	// Too far apart for the bigfloat; handled by the fallback
+	CHECK( Bounded::side_of_oriented_circle(1e300, 0.0, 0.0, 1e300, -1e300, 0.0, 1e-300, -1e300)
+	  == Reference::side_of_oriented_circle(1e300, 0.0, 0.0, 1e300, -1e300, 0.0, 1e-300, -1e300) );
+}
+
+TEST_CASE("Check double_double error bounds", "[double_double]") {
+	using DD = ra::math::double_double;
+	using MP = CGAL::MP_Float;
+	std::mt19937_64 engine {11};
+	std::uniform_real_distribution<double> unit {-1.0, 1.0};
+	auto exact = []( const DD& x ) { return MP(x.hi()) + MP(x.lo()); };
+	// |computed - exact| <= c u^2 |exact|
+	auto within = [&]( const DD& computed, const MP& value, int c ) {
+		MP error = exact(computed) - value;
+		MP scaled = error * MP(0x1p106);
+		MP bound = value * MP(double(c));
+		if( ra::geometry::sign_of(scaled) < 0 ) {
+			scaled = MP(0) - scaled;
+		}
+		if( ra::geometry::sign_of(bound) < 0 ) {
+			bound = MP(0) - bound;
+		}
+		return !(bound < scaled);
+	};
+	ra::math::rounding_region region(FE_TONEAREST);
+	for( int i = 0; i < 5000; ++i ) {
+		DD x = DD(unit(engine)) * DD(unit(engine)) + DD(unit(engine) * 1e-17);
+		DD y = DD(unit(engine)) * DD(unit(engine)) - DD(unit(engine) * 1e-17);
+		CHECK( within(x + y, exact(x) + exact(y), DD::add_error) );
+		CHECK( within(x - y, exact(x) - exact(y), DD::add_error) );
+		CHECK( within(x * y, exact(x) * exact(y), DD::mul_error) );
+	}
+	// Differences of doubles are exact
+	DD d = DD(1.0) - DD(0x1p-80);
+	CHECK( d.hi() == 1.0 );
+	CHECK( d.lo() == -0x1p-80 );
+}
+
+namespace {
+
+struct xy {
+	double x_;
+	double y_;
+	double x() const { return x_; }
+	double y() const { return y_; }
+};
+
+// Check that a filter stage is either uncertain or agrees with Reference
+// on orientation, and count the tests it decides.
+template<class F>
+int decided_orientations( const F& filter ) {
+	point_source s;
+	int decided = 0;
+	for( int i = 0; i < 2000; ++i ) {
+		xy a {s.coordinate(1.0), s.coordinate(1.0)};
+		xy b {s.coordinate(1.0), s.coordinate(1.0)};
+		xy c {s.perturb( 2.0 * b.x() - a.x() ), s.perturb( 2.0 * b.y() - a.y() )};
+		if( i % 4 == 0 ) {
+			c = {s.coordinate(1.0), s.coordinate(1.0)};
+		}
+		ra::math::certain_sign sign = filter.orientation(a, b, c);
+		if( sign != ra::math::certain_sign::uncertain ) {
+			++decided;
+			CHECK( static_cast<int>(sign)
+			  == Reference::orientation(a.x(), a.y(), b.x(), b.y(), c.x(), c.y()) );
+		}
+	}
+	return decided;
+}
+
+}
+
+TEST_CASE("Check filter stages against MP_Float", "[filters]") {
+	using Interval = ra::math::interval<double, ra::math::protected_rounding<double>>;
+	int static_decided = decided_orientations( ra::geometry::static_filter<double>() );
+	int interval_decided = decided_orientations( ra::geometry::interval_filter<Interval>() );
+	int double_double_decided = decided_orientations( ra::geometry::double_double_filter() );
+	int exact_decided = decided_orientations( ra::geometry::exact_filter<Expansion>() );
+	// Random triples are decided by every stage; nearly collinear ones
+	// only by the more precise stages
+	CHECK( static_decided >= 500 );
+	CHECK( interval_decided >= static_decided );
+	CHECK( double_double_decided > interval_decided );
+	CHECK( exact_decided == 2000 );
+}
+
+TEST_CASE("Check preferred_direction statistics of each stage", "[filters]") {
+	using Kernel = ra::geometry::Kernel<double>;
+	Kernel kernel;
+	kernel.configure_for_bbox( 1.0 );
+	Kernel::Vector v(1, 1);
+	point_source s;
+	Kernel::Statistics before;
+	Kernel::get_thread_statistics( before );
+	for( int i = 0; i < 1000; ++i ) {
+		Kernel::Point p[4];
+		for( Kernel::Point& q : p ) {
+			q = Kernel::Point(s.coordinate(1.0), s.coordinate(1.0));
+		}
+		// Every fourth test is exactly degenerate (a == c and b == d)
+		if( i % 4 == 0 ) {
+			p[2] = p[0];
+			p[3] = p[1];
+		}
+		CHECK( kernel.preferred_direction(p[0], p[1], p[2], p[3], v)
+		  == Reference::preferred_direction(p[0].x(), p[0].y(), p[1].x(), p[1].y(),
+		  p[2].x(), p[2].y(), p[3].x(), p[3].y(), v.x(), v.y()) );
+	}
+#if RA_GEOMETRY_STATS
+	Kernel::Statistics after;
+	Kernel::get_thread_statistics( after );
+	std::size_t total = after.preferred_direction_total_count
+	  - before.preferred_direction_total_count;
+	std::size_t interval = after.preferred_direction_interval_count
+	  - before.preferred_direction_interval_count;
+	CHECK( total == 1000 );
+	// The static filter decides the random tests; only the degenerate
+	// ones reach the interval stage
+	CHECK( interval >= 250 );
+	CHECK( interval < 300 );
+	CHECK( after.preferred_direction_exact_count - before.preferred_direction_exact_count
+	  <= interval );
+#endif
+}
+
+TEST_CASE("Check float_filter orientation against MP_Float", "[filters]") {
+	// Float coordinates of very different magnitudes, exactly collinear
+	// points on scaled lattices, and points perturbed from those by an
+	// ulp; the stage decides every test, and the kernel over float never
+	// reaches a later stage for orientation
+	using Point = ra::geometry::Kernel<float>::Point;
+	ra::geometry::float_filter filter;
+	ra::geometry::Kernel<float> kernel;
+	ra::geometry::Kernel<float>::clear_statistics();
+	std::mt19937_64 engine {2024};
+	std::uniform_real_distribution<float> unit {-1.0f, 1.0f};
+	std::uniform_int_distribution<int> exponent {-60, 60};
+	std::uniform_int_distribution<int> lattice {-50, 50};
+	auto coordinate = [&]() { return std::ldexp(unit(engine), exponent(engine)); };
+	for( int i = 0; i < 20000; ++i ) {
+		Point a;
+		Point b;
+		Point c;
+		if( i % 2 == 0 ) {
+			a = Point(coordinate(), coordinate());
+			b = Point(coordinate(), coordinate());
+			c = Point(coordinate(), coordinate());
+		}else {
+			float scale = std::ldexp(1.0f, exponent(engine));
+			int dx = lattice(engine);
+			int dy = lattice(engine);
+			int t = lattice(engine);
+			float ox = lattice(engine) * scale;
+			float oy = lattice(engine) * scale;
+			a = Point(ox, oy);
+			b = Point(ox + dx * scale, oy + dy * scale);
+			c = Point(ox + t * dx * scale, oy + t * dy * scale);
+			if( i % 4 == 1 ) {
+				c = Point(std::nextafter(c.x(), 1e30f), c.y());
+			}
+		}
+		int expected = Reference::orientation(a.x(), a.y(), b.x(), b.y(), c.x(), c.y());
+		CHECK( static_cast<int>(filter.orientation(a, b, c)) == expected );
+		CHECK( static_cast<int>(kernel.orientation(a, b, c)) == expected );
+	}
+	ra::geometry::Kernel<float>::Statistics statistics;
+	ra::geometry::Kernel<float>::get_statistics( statistics );
+	CHECK( statistics.orientation_interval_count == 0 );
+	CHECK( statistics.orientation_exact_count == 0 );
+}
+
+TEST_CASE("Check float_filter side_of_oriented_circle against MP_Float", "[filters]") {
+	// Random quads and cocircular quads on a lattice, some of them moved
+	// by an ulp, in a box whose bound 0.7 rounds down to float; the
+	// stage filters each test in float and then in double, and each sign
+	// it decides must be right, configured or not
+	using Point = ra::geometry::Kernel<float>::Point;
+	ra::geometry::float_filter filter;
+	ra::geometry::float_filter bbox_filter;
+	bbox_filter.configure_for_bbox( 0.7, 1.0 );
+	std::mt19937_64 engine {2024};
+	std::uniform_real_distribution<float> unit {-0.7f, 0.7f};
+	std::uniform_int_distribution<int> lattice {-7, 7};
+	int decided = 0;
+	for( int i = 0; i < 20000; ++i ) {
+		Point p[4];
+		if( i % 2 == 0 ) {
+			for( Point& q : p ) {
+				q = Point(unit(engine), unit(engine));
+			}
+		}else {
+			// Corners of a rectangle, which are cocircular
+			float x0 = lattice(engine) * 0.1f;
+			float y0 = lattice(engine) * 0.1f;
+			float x1 = lattice(engine) * 0.1f;
+			float y1 = lattice(engine) * 0.1f;
+			p[0] = Point(x0, y0);
+			p[1] = Point(x1, y0);
+			p[2] = Point(x1, y1);
+			p[3] = Point(x0, y1);
+			if( i % 4 == 1 ) {
+				p[3] = Point(std::nextafter(x0, 1.0f), y1);
+			}
+		}
+		int expected = Reference::side_of_oriented_circle(p[0].x(), p[0].y(), p[1].x(),
+		  p[1].y(), p[2].x(), p[2].y(), p[3].x(), p[3].y());
+		for( const ra::geometry::float_filter* f : {&filter, &bbox_filter} ) {
+			ra::math::certain_sign sign = f->side_of_oriented_circle(p[0], p[1], p[2], p[3]);
+			if( sign != ra::math::certain_sign::uncertain ) {
+				++decided;
+				CHECK( static_cast<int>(sign) == expected );
+			}
+		}
+	}
+	CHECK( decided >= 20000 );
+}
+
+TEST_CASE("Check side_of_oriented_circle far from the origin", "[filters]") {
+	// Random quads in a unit square far from the origin: lifting the
+	// untranslated points would leave most of them to the exact stage
+	using Interval = ra::math::interval<double, ra::math::protected_rounding<double>>;
+	ra::geometry::interval_filter<Interval> filter;
+	point_source s;
+	int decided = 0;
+	for( int i = 0; i < 2000; ++i ) {
+		xy p[4];
+		for( xy& q : p ) {
+			q = {1e8 + s.coordinate(1.0), 1e8 + s.coordinate(1.0)};
+		}
+		int exact = Reference::side_of_oriented_circle(p[0].x(), p[0].y(), p[1].x(),
+		  p[1].y(), p[2].x(), p[2].y(), p[3].x(), p[3].y());
+		CHECK( Bounded::side_of_oriented_circle(p[0].x(), p[0].y(), p[1].x(), p[1].y(),
+		  p[2].x(), p[2].y(), p[3].x(), p[3].y()) == exact );
+		ra::math::certain_sign sign = filter.side_of_oriented_circle(p[0], p[1], p[2], p[3]);
+		if( sign != ra::math::certain_sign::uncertain ) {
+			++decided;
+			CHECK( static_cast<int>(sign) == exact );
+		}
+	}
+	CHECK( decided >= 1990 );
+}
+
+namespace {
+
+// Check classify_quad against the separate predicates on random quads,
+// cocircular rectangles and quads with collinear corners.
+template<class K>
+void check_classify_quad( K& kernel ) {
+	using Point = typename K::Point;
+	typename K::Vector u(1, 0);
+	typename K::Vector v(1, 1);
+	point_source s;
+	std::uniform_int_distribution<int> lattice {0, 8};
+	for( int i = 0; i < 4000; ++i ) {
+		Point p[4];
+		if( i % 3 == 0 ) {
+			for( Point& q : p ) {
+				q = Point(s.coordinate(1.0), s.coordinate(1.0));
+			}
+		}else if( i % 3 == 1 ) {
+			double x = lattice(s.engine) * 0.1;
+			double y = lattice(s.engine) * 0.1;
+			double x2 = x + (lattice(s.engine) + 1) * 0.1;
+			double y2 = y + (lattice(s.engine) + 1) * 0.1;
+			p[0] = Point(x, y);
+			p[1] = Point(x2, y);
+			p[2] = Point(x2, y2);
+			p[3] = Point(x, y2);
+		}else {
+			for( Point& q : p ) {
+				q = Point(lattice(s.engine) * 0.1, lattice(s.engine) * 0.1);
+			}
+		}
+		typename K::Quad_classification result = kernel.classify_quad(p[0], p[1], p[2], p[3], u, v);
+		CHECK( result.locally_pd_delaunay
+		  == kernel.is_locally_pd_delaunay_edge(p[2], p[3], p[0], p[1], u, v) );
+		// Convexity is only decided for a diagonal that is not locally
+		// Delaunay
+		CHECK( result.strictly_convex == (!result.locally_pd_delaunay
+		  && kernel.is_strictly_convex_quad(p[0], p[1], p[2], p[3])) );
+	}
+}
+
+}
+
+TEST_CASE("Check classify_quad against the separate predicates", "[kernel]") {
+	using Kernel = ra::geometry::Kernel<double>;
+	Kernel kernel;
+	check_classify_quad( kernel );
+	Kernel bbox_kernel;
+	bbox_kernel.configure_for_bbox( 2.0 );
+	check_classify_quad( bbox_kernel );
+	// A chain without a static filter
+	ra::geometry::Kernel<double,
+	  ra::geometry::interval_filter<ra::geometry::default_interval<double>::type>,
+	  ra::geometry::exact_filter<Expansion>> interval_kernel;
+	check_classify_quad( interval_kernel );
+}
+
+namespace {
+
+// A vertex that keeps the kernel's Point_cache, as those of
+// trilib::Triangulation_2 do.
+template<class K>
+struct cached_vertex {
+	typename K::Point p;
+	mutable typename K::Point_cache cache;
+
+	const typename K::Point& point() const { return p; }
+	typename K::Point_cache& point_cache() const { return cache; }
+};
+
+// A vertex that also has an id, as those of trilib::Triangulation_2 do.
+template<class K>
+struct numbered_vertex : cached_vertex<K> {
+	std::size_t index;
+
+	std::size_t id() const { return index; }
+};
+
+// The orientation of the tetrahedron of the points (x[k], y[k], z[k]),
+// which is the side-of-oriented-circle determinant of their projections
+// if z[k] is the lift x[k]^2 + y[k]^2.
+template<class NT>
+NT lifted_orientation( const NT (&x)[4], const NT (&y)[4], const NT (&z)[4] ) {
+	NT ax = x[0] - x[3], ay = y[0] - y[3], az = z[0] - z[3];
+	NT bx = x[1] - x[3], by = y[1] - y[3], bz = z[1] - z[3];
+	NT cx = x[2] - x[3], cy = y[2] - y[3], cz = z[2] - z[3];
+	return (ax * ((by * cz) - (bz * cy))) - (bx * ((ay * cz) - (az * cy)))
+	  + (cx * ((ay * bz) - (az * by)));
+}
+
+// Check the perturbed side-of-oriented-circle test against the
+// determinant with the lift of each vertex raised by eps^(1 + id) for
+// eps = 2^-20, evaluated exactly, on points of a small integer lattice
+// (many of them collinear or cocircular). The determinant of the
+// unperturbed points and the coefficients of the lifts are then integers
+// of magnitude at most 2^5, so that this eps is small enough.
+template<class K>
+void check_perturbed( K& kernel ) {
+	using Point = typename K::Point;
+	using NT = CGAL::MP_Float;
+	point_source s;
+	std::uniform_int_distribution<int> lattice {0, 4};
+	numbered_vertex<K> vertices[6];
+	for( std::size_t i = 0; i < 6; ++i ) {
+		vertices[i].index = (5 * i + 2) % 6;
+	}
+	for( int i = 0; i < 4000; ++i ) {
+		vertices[i % 6].p = Point(lattice(s.engine), lattice(s.engine));
+		const numbered_vertex<K>* h[4] = {&vertices[i % 6], &vertices[(i + 1) % 6],
+		  &vertices[(i + 3) % 6], &vertices[(i + 4) % 6]};
+		NT x[4];
+		NT y[4];
+		NT z[4];
+		for( int k = 0; k < 4; ++k ) {
+			x[k] = NT(h[k]->p.x());
+			y[k] = NT(h[k]->p.y());
+			z[k] = (x[k] * x[k]) + (y[k] * y[k]) + NT(std::ldexp(1.0, -20 * int(1 + h[k]->id())));
+		}
+		int expected = ra::geometry::sign_of( lifted_orientation(x, y, z) );
+		typename K::Oriented_side side = kernel.side_of_oriented_circle_perturbed(h[0], h[1], h[2], h[3]);
+		CHECK( static_cast<int>(side) == expected );
+		typename K::Quad_classification quad = kernel.classify_quad_perturbed(h[0], h[1], h[2], h[3]);
+		CHECK( quad.locally_pd_delaunay == (expected < 0) );
+		CHECK( quad.strictly_convex == ((expected >= 0)
+		  && kernel.is_strictly_convex_quad(h[0]->p, h[1]->p, h[2]->p, h[3]->p)) );
+	}
+}
+
+}
+
+TEST_CASE("Check the perturbed side_of_oriented_circle against a small perturbation", "[kernel]") {
+	ra::geometry::Kernel<double> kernel;
+	check_perturbed( kernel );
+	ra::geometry::Kernel<double, ra::geometry::exact_filter<Expansion>> exact_kernel;
+	check_perturbed( exact_kernel );
+}
+
+TEST_CASE("Check classify_quad with the predicate cache against without", "[kernel]") {
+	using Kernel = ra::geometry::Kernel<double>;
+	using Point = Kernel::Point;
+	Kernel uncached;
+	Kernel kernel;
+	Kernel perturbed_kernel;
+	// Few entries, so that quads often evict each other
+	kernel.enable_predicate_cache(3);
+	perturbed_kernel.enable_predicate_cache(3);
+	Kernel::Vector directions[] = {Kernel::Vector(1, 0), Kernel::Vector(1, 1),
+	  Kernel::Vector(0, 1)};
+	point_source s;
+	std::uniform_int_distribution<int> lattice {0, 8};
+	std::uniform_int_distribution<int> vertex {0, 5};
+	numbered_vertex<Kernel> vertices[6];
+	for( std::size_t i = 0; i < 6; ++i ) {
+		vertices[i].index = i;
+		vertices[i].p = Point(lattice(s.engine) * 0.1, lattice(s.engine) * 0.1);
+	}
+	Kernel::Statistics before;
+	Kernel::get_thread_statistics( before );
+	for( int i = 0; i < 8000; ++i ) {
+		// Move a vertex now and then, and change the preferred directions
+		// about as often, so that many quads are classified again unchanged
+		if( i % 13 == 0 ) {
+			numbered_vertex<Kernel>& moved = vertices[vertex(s.engine)];
+			moved.p = (i % 2 == 0)
+			  ? Point(s.coordinate(1.0), s.coordinate(1.0))
+			  : Point(lattice(s.engine) * 0.1, lattice(s.engine) * 0.1);
+			Kernel::invalidate_predicate_cache(&moved);
+		}
+		const Kernel::Vector& u = directions[(i / 12) % 3];
+		const Kernel::Vector& v = directions[(i / 12 + 1) % 3];
+		int k = i % 3;
+		const numbered_vertex<Kernel>* h[4] = {&vertices[k], &vertices[k + 1],
+		  &vertices[k + 2], &vertices[(i % 2 == 0) ? k + 3 : 5]};
+		// The same quad from its other side, half of the time
+		if( (i / 3) % 2 == 1 ) {
+			std::swap( h[0], h[2] );
+			std::swap( h[1], h[3] );
+		}
+		Kernel::Quad_classification expected = uncached.classify_quad(h[0]->p, h[1]->p,
+		  h[2]->p, h[3]->p, u, v);
+		Kernel::Quad_classification quad = kernel.classify_quad(h[0], h[1], h[2], h[3], u, v);
+		CHECK( quad.strictly_convex == expected.strictly_convex );
+		CHECK( quad.locally_pd_delaunay == expected.locally_pd_delaunay );
+		Kernel::Quad_classification perturbed = perturbed_kernel.classify_quad_perturbed(h[0],
+		  h[1], h[2], h[3]);
+		CHECK( perturbed.strictly_convex == (!perturbed.locally_pd_delaunay
+		  && uncached.is_strictly_convex_quad(h[0]->p, h[1]->p, h[2]->p, h[3]->p)) );
+		CHECK( perturbed.locally_pd_delaunay
+		  == (uncached.side_of_oriented_circle_perturbed(h[0], h[1], h[2], h[3])
+		  == Kernel::Oriented_side::on_negative_side) );
+		// Both tie-breaks through the same cache, now and then
+		if( i % 5 == 0 ) {
+			CHECK( kernel.classify_quad_perturbed(h[0], h[1], h[2], h[3]).locally_pd_delaunay
+			  == perturbed.locally_pd_delaunay );
+		}
+	}
+#if RA_GEOMETRY_STATS
+	Kernel::Statistics after;
+	Kernel::get_thread_statistics( after );
+	CHECK( after.predicate_cache_hit_count > before.predicate_cache_hit_count );
+	CHECK( after.predicate_cache_miss_count > before.predicate_cache_miss_count );
+#endif
+	// Ids that do not fit in 32 bits bypass the cache
+	if constexpr( sizeof(std::size_t) > 4 ) {
+		for( numbered_vertex<Kernel>& moved : vertices ) {
+			moved.index += std::size_t(1) << 32;
+		}
+		const numbered_vertex<Kernel>* h[4] = {&vertices[0], &vertices[1], &vertices[2],
+		  &vertices[3]};
+		for( int i = 0; i < 2; ++i ) {
+			Kernel::Quad_classification expected = uncached.classify_quad(h[0]->p, h[1]->p,
+			  h[2]->p, h[3]->p, directions[0], directions[1]);
+			Kernel::Quad_classification quad = kernel.classify_quad(h[0], h[1], h[2], h[3],
+			  directions[0], directions[1]);
+			CHECK( quad.strictly_convex == expected.strictly_convex );
+			CHECK( quad.locally_pd_delaunay == expected.locally_pd_delaunay );
+			vertices[0].p = Point(s.coordinate(1.0), s.coordinate(1.0));
+		}
+	}
+}
+
+namespace {
+
+// Check the batched predicates against one call per test, on random and
+// lattice points (many of them collinear or cocircular), with a number of
+// tests that is not a multiple of the batch width.
+template<class K, class Index>
+void check_batches( K& kernel ) {
+	using Point = typename K::Point;
+	constexpr std::size_t num_points = 200;
+	constexpr std::size_t num_tests = 4003;
+	point_source s;
+	std::uniform_int_distribution<int> lattice {0, 8};
+	std::uniform_int_distribution<Index> index {0, num_points - 1};
+	std::vector<double> x(num_points);
+	std::vector<double> y(num_points);
+	for( std::size_t i = 0; i < num_points; ++i ) {
+		x[i] = (i % 2) ? s.coordinate(1.0) : lattice(s.engine) * 0.1;
+		y[i] = (i % 2) ? s.coordinate(1.0) : lattice(s.engine) * 0.1;
+	}
+	std::unique_ptr<Index[][3]> triples(new Index[num_tests][3]);
+	std::unique_ptr<Index[][4]> quads(new Index[num_tests][4]);
+	for( std::size_t k = 0; k < num_tests; ++k ) {
+		for( Index& i : triples[k] ) {
+			i = index(s.engine);
+		}
+		for( Index& i : quads[k] ) {
+			i = index(s.engine);
+		}
+	}
+	std::vector<typename K::Orientation> orientations(num_tests);
+	std::vector<typename K::Oriented_side> sides(num_tests);
+	kernel.orientation_batch( x.data(), y.data(), triples.get(), num_tests, orientations.data() );
+	kernel.side_of_oriented_circle_batch( x.data(), y.data(), quads.get(), num_tests,
+	  sides.data() );
+	auto point = [&]( Index i ) { return Point(x[i], y[i]); };
+	for( std::size_t k = 0; k < num_tests; ++k ) {
+		const Index* t = triples[k];
+		const Index* q = quads[k];
+		CHECK( orientations[k] == kernel.orientation(point(t[0]), point(t[1]), point(t[2])) );
+		CHECK( sides[k] == kernel.side_of_oriented_circle(point(q[0]), point(q[1]),
+		  point(q[2]), point(q[3])) );
+	}
+}
+
+}
+
+TEST_CASE("Check batched predicates against one call per test", "[kernel]") {
+	using Kernel = ra::geometry::Kernel<double>;
+	Kernel kernel;
+	check_batches<Kernel, unsigned>( kernel );
+	check_batches<Kernel, std::size_t>( kernel );
+	Kernel bbox_kernel;
+	bbox_kernel.configure_for_bbox( 1.0 );
+	check_batches<Kernel, int>( bbox_kernel );
+	// A chain whose first stage has no batched tests
+	ra::geometry::Kernel<double,
+	  ra::geometry::interval_filter<ra::geometry::default_interval<double>::type>,
+	  ra::geometry::exact_filter<Expansion>> interval_kernel;
+	check_batches<decltype(interval_kernel), unsigned>( interval_kernel );
+}
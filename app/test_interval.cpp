@@ -1,7 +1,10 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 #include "ra/interval.hpp"
+#include "ra/packed_interval.hpp"
 #include <iostream>
+#include <thread>
+#include <vector>
 
 TEMPLATE_TEST_CASE("Check default constructor with parameter", "[constructor]", float, double, long double) {
 	ra::math::interval zerod {0};
@@ -185,3 +188,265 @@ TEMPLATE_TEST_CASE("Test < operator", "[operator]", float, double, long double)
 		std::cout << "Exception from < operation caught.\t" << e.what() << '\n';
 	}
 }
+
+TEMPLATE_TEST_CASE("Check bounds are rounded outward", "[rounding]", float, double, long double) {
+	ra::math::interval<TestType> a {TestType(1)};
+	ra::math::interval<TestType> b {TestType(3)};
+	ra::math::interval<TestType> c {TestType(1) / TestType(3)};
+	ra::math::interval<TestType> sum = a + c;
+	ra::math::interval<TestType> diff = a - c;
+	ra::math::interval<TestType> prod = c * c;
+	ra::math::interval<TestType> sum2 {TestType(1)};
+	sum2 += c;
+
+	// None of these results are representable, so each must be bracketed
+	// by two distinct bounds.
+	CHECK( sum.lower() < sum.upper() );
+	CHECK( diff.lower() < diff.upper() );
+	CHECK( prod.lower() < prod.upper() );
+	CHECK( sum == sum2 );
+	CHECK( (b * c).lower() < (b * c).upper() );
+
+	// The caller's rounding mode is left untouched.
+	CHECK( std::fegetround() == FE_TONEAREST );
+}
+
+TEMPLATE_TEST_CASE("Check protected rounding region", "[rounding]", float, double, long double) {
+	using checked = ra::math::interval<TestType>;
+	using unchecked = ra::math::interval<TestType, ra::math::protected_rounding<TestType>>;
+	TestType x = TestType(1) / TestType(3);
+	TestType y = TestType(-2) / TestType(7);
+
+	checked a {x, TestType(1)};
+	checked b {y, x};
+	checked sum = a + b;
+	checked diff = a - b;
+	checked prod = a * b;
+	{
+		ra::math::rounding_region region;
+		CHECK( std::fegetround() == FE_UPWARD );
+		unchecked pa {x, TestType(1)};
+		unchecked pb {y, x};
+		unchecked psum = pa + pb;
+		unchecked pdiff = pa - pb;
+		unchecked pprod = pa * pb;
+
+		// The region must give exactly the bounds of the checked policy.
+		CHECK( psum.lower() == sum.lower() );
+		CHECK( psum.upper() == sum.upper() );
+		CHECK( pdiff.lower() == diff.lower() );
+		CHECK( pdiff.upper() == diff.upper() );
+		CHECK( pprod.lower() == prod.lower() );
+		CHECK( pprod.upper() == prod.upper() );
+	}
+	CHECK( std::fegetround() == FE_TONEAREST );
+}
+
+TEMPLATE_TEST_CASE("Check negated lower bound storage", "[storage]", float, double, long double) {
+	using endpoint = ra::math::interval<TestType>;
+	using negated = ra::math::interval<TestType, ra::math::checked_rounding<TestType>,
+	  ra::math::negated_lower_storage>;
+	TestType third = TestType(1) / TestType(3);
+	TestType bounds[][2] = {
+		{-2, -1}, {-1, 1}, {1, 2}, {0, 0}, {-third, third},
+		{third, 1}, {-1, -third}, {0, third}, {-third, 0},
+	};
+
+	for( auto& x : bounds ) {
+		for( auto& y : bounds ) {
+			endpoint a {x[0], x[1]};
+			endpoint b {y[0], y[1]};
+			negated na {x[0], x[1]};
+			negated nb {y[0], y[1]};
+			CHECK( (na + nb).lower() == (a + b).lower() );
+			CHECK( (na + nb).upper() == (a + b).upper() );
+			CHECK( (na - nb).lower() == (a - b).lower() );
+			CHECK( (na - nb).upper() == (a - b).upper() );
+			CHECK( (na * nb).lower() == (a * b).lower() );
+			CHECK( (na * nb).upper() == (a * b).upper() );
+		}
+	}
+
+	negated n {third};
+	n -= n;
+	CHECK( n.lower() == 0 );
+	CHECK( n.upper() == 0 );
+	CHECK( negated {-third, third}.is_singleton() == false );
+	CHECK( negated {third}.sign() == 1 );
+	CHECK( std::fegetround() == FE_TONEAREST );
+}
+
+#if defined(__SSE2__)
+TEST_CASE("Check packed interval", "[storage]") {
+	using endpoint = ra::math::interval<double>;
+	using packed = ra::math::interval<double, ra::math::checked_rounding<double>,
+	  ra::math::packed_storage>;
+	double third = 1.0 / 3.0;
+	double bounds[][2] = {
+		{-2, -1}, {-1, 1}, {1, 2}, {0, 0}, {-third, third},
+		{third, 1}, {-1, -third}, {0, third}, {-third, 0},
+	};
+
+	for( auto& x : bounds ) {
+		for( auto& y : bounds ) {
+			endpoint a {x[0], x[1]};
+			endpoint b {y[0], y[1]};
+			packed pa {x[0], x[1]};
+			packed pb {y[0], y[1]};
+			CHECK( (pa + pb).lower() == (a + b).lower() );
+			CHECK( (pa + pb).upper() == (a + b).upper() );
+			CHECK( (pa - pb).lower() == (a - b).lower() );
+			CHECK( (pa - pb).upper() == (a - b).upper() );
+			CHECK( (pa * pb).lower() == (a * b).lower() );
+			CHECK( (pa * pb).upper() == (a * b).upper() );
+		}
+	}
+
+	packed p {third};
+	p *= p;
+	CHECK( p.lower() < p.upper() );
+	CHECK( p.sign() == 1 );
+	CHECK( packed {-1, 1} < packed {2} );
+	CHECK( std::fegetround() == FE_TONEAREST );
+}
+#endif
+
+TEMPLATE_TEST_CASE("Check branchless multiplication", "[operator]", float, double, long double) {
+	using endpoint = ra::math::interval<TestType>;
+	using negated = ra::math::interval<TestType, ra::math::checked_rounding<TestType>,
+	  ra::math::negated_lower_storage>;
+	TestType third = TestType(1) / TestType(3);
+	TestType bounds[][2] = {
+		{-2, -1}, {-1, 1}, {1, 2}, {0, 0}, {-third, third},
+		{third, 1}, {-1, -third}, {0, third}, {-third, 0}, {-third, 2},
+	};
+
+	for( auto& x : bounds ) {
+		for( auto& y : bounds ) {
+			endpoint a {x[0], x[1]};
+			endpoint b {x[0], x[1]};
+			a.multiply_by_lookup( endpoint {y[0], y[1]} );
+			b.multiply_branchless( endpoint {y[0], y[1]} );
+			CHECK( a == b );
+			negated na {x[0], x[1]};
+			negated nb {x[0], x[1]};
+			na.multiply_by_lookup( negated {y[0], y[1]} );
+			nb.multiply_branchless( negated {y[0], y[1]} );
+			CHECK( na == nb );
+			CHECK( na.lower() == a.lower() );
+			CHECK( na.upper() == a.upper() );
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("Check statistics", "[statistics]", float, double, long double) {
+	using interval = ra::math::interval<TestType>;
+	typename interval::statistics stats;
+	interval::clear_statistics();
+
+	interval a {-1, 2};
+	interval b {1, 3};
+	a += b;
+	a *= b;
+	CHECK_THROWS_AS( interval(-1, 1).sign(), ra::math::indeterminate_result );
+
+	interval::get_statistics( stats );
+#if RA_GEOMETRY_STATS
+	CHECK( stats.arithmetic_op_count == 2 );
+	CHECK( stats.indeterminate_result_count == 1 );
+#else
+	CHECK( stats.arithmetic_op_count == 0 );
+	CHECK( stats.indeterminate_result_count == 0 );
+#endif
+
+	interval::clear_statistics();
+	interval::get_statistics( stats );
+	CHECK( stats.arithmetic_op_count == 0 );
+	CHECK( stats.indeterminate_result_count == 0 );
+}
+
+TEST_CASE("Check statistics are merged across threads", "[statistics]") {
+	using interval = ra::math::interval<double>;
+	constexpr int num_threads = 4;
+	constexpr unsigned long ops_per_thread = 1000;
+	interval::statistics stats;
+	interval::clear_statistics();
+
+	std::vector<std::thread> workers;
+	std::vector<unsigned long> thread_counts(num_threads);
+	for( int t = 0; t < num_threads; ++t ) {
+		workers.emplace_back( [t, &thread_counts]() {
+			interval a {1, 2};
+			for( unsigned long i = 0; i < ops_per_thread; ++i ) {
+				a += interval {0, 1};
+			}
+			interval::statistics local;
+			interval::get_thread_statistics( local );
+			thread_counts[t] = local.arithmetic_op_count;
+		});
+	}
+	for( auto& w : workers ) {
+		w.join();
+	}
+
+	interval a {1, 2};
+	a *= a;
+	interval::get_thread_statistics( stats );
+#if RA_GEOMETRY_STATS
+	CHECK( stats.arithmetic_op_count == 1 );
+	for( auto count : thread_counts ) {
+		CHECK( count == ops_per_thread );
+	}
+#endif
+
+	interval::get_statistics( stats );
+#if RA_GEOMETRY_STATS
+	CHECK( stats.arithmetic_op_count == num_threads * ops_per_thread + 1 );
+#else
+	CHECK( stats.arithmetic_op_count == 0 );
+#endif
+}
+
+TEMPLATE_TEST_CASE("Check non-throwing sign and comparison", "[sign]", float, double, long double) {
+	using interval = ra::math::interval<TestType>;
+	using ra::math::certain_sign;
+	interval neg {-2, -1};
+	interval zero {0, 0};
+	interval pos {1, 2};
+	interval straddling {-1, 1};
+	interval touching {0, 1};
+
+	CHECK( neg.sign_or_uncertain() == certain_sign::negative );
+	CHECK( zero.sign_or_uncertain() == certain_sign::zero );
+	CHECK( pos.sign_or_uncertain() == certain_sign::positive );
+	CHECK( straddling.sign_or_uncertain() == certain_sign::uncertain );
+	CHECK( touching.sign_or_uncertain() == certain_sign::uncertain );
+
+	CHECK( neg.certainly_negative() );
+	CHECK_FALSE( neg.possibly_zero() );
+	CHECK( zero.certainly_zero() );
+	CHECK( zero.possibly_zero() );
+	CHECK( pos.certainly_positive() );
+	CHECK_FALSE( straddling.certainly_negative() );
+	CHECK_FALSE( straddling.certainly_positive() );
+	CHECK_FALSE( straddling.certainly_zero() );
+	CHECK( straddling.possibly_zero() );
+	CHECK( touching.possibly_zero() );
+
+	CHECK( ra::math::certainly_less(neg, pos) );
+	CHECK( ra::math::certainly_not_less(pos, neg) );
+	CHECK_FALSE( ra::math::certainly_less(straddling, touching) );
+	CHECK_FALSE( ra::math::certainly_not_less(straddling, touching) );
+	CHECK_THROWS_AS( straddling < touching, ra::math::indeterminate_result );
+
+#if defined(__SSE2__)
+	using packed = ra::math::interval<double, ra::math::checked_rounding<double>,
+	  ra::math::packed_storage>;
+	CHECK( packed(-2, -1).sign_or_uncertain() == certain_sign::negative );
+	CHECK( packed(0, 0).sign_or_uncertain() == certain_sign::zero );
+	CHECK( packed(1, 2).sign_or_uncertain() == certain_sign::positive );
+	CHECK( packed(-1, 1).sign_or_uncertain() == certain_sign::uncertain );
+	CHECK( packed(-1, 1).possibly_zero() );
+	CHECK( ra::math::certainly_less(packed(-2, -1), packed(1, 2)) );
+#endif
+}
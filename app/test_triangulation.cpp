@@ -0,0 +1,225 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+#include "compact_triangulation_2.hpp"
+#include "delaunay.hpp"
+#include "ra/kernel.hpp"
+#include "triangulation_2.hpp"
+#include <CGAL/Simple_cartesian.h>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <string>
+
+using Kernel = ra::geometry::Kernel<CGAL::Simple_cartesian<double>>;
+using Grid_kernel = ra::geometry::Kernel<CGAL::Simple_cartesian<std::int32_t>>;
+
+namespace {
+
+// An n by n grid of squares of side 1, each split into two triangles by
+// its diagonal, in OFF format. The interior vertices are moved by up to
+// jitter in each coordinate (which must be less than 1/4 to keep the
+// faces counterclockwise); with no jitter, nearly every quadrilateral is
+// cocircular.
+std::string grid_off( int n, double jitter, unsigned seed = 2024 ) {
+	std::mt19937_64 engine {seed};
+	std::uniform_real_distribution<double> offset {-jitter, jitter};
+	std::ostringstream out;
+	out.precision(17);
+	out << "OFF\n" << (n + 1) * (n + 1) << ' ' << 2 * n * n << " 0\n";
+	for( int j = 0; j <= n; ++j ) {
+		for( int i = 0; i <= n; ++i ) {
+			double x = i;
+			double y = j;
+			if( i > 0 && i < n && j > 0 && j < n ) {
+				x += offset(engine);
+				y += offset(engine);
+			}
+			out << x << ' ' << y << " 0\n";
+		}
+	}
+	for( int j = 0; j < n; ++j ) {
+		for( int i = 0; i < n; ++i ) {
+			int a = j * (n + 1) + i;
+			int b = a + 1;
+			int c = b + n + 1;
+			int d = a + n + 1;
+			out << "3 " << a << ' ' << b << ' ' << c << '\n';
+			out << "3 " << a << ' ' << c << ' ' << d << '\n';
+		}
+	}
+	return out.str();
+}
+
+template <class Triangulation>
+std::string to_off( const Triangulation& tri ) {
+	std::ostringstream out;
+	tri.output_off(out);
+	return out.str();
+}
+
+// The connectivity of a triangulation is consistent: opposite is an
+// involution, next and prev are inverses, every halfedge of a loop has
+// the loop's face, each finite face is a triangle, and the halfedges of
+// the vertices and faces are incident to them.
+template <class Triangulation>
+void check_connectivity( Triangulation& tri ) {
+	for( auto h = tri.halfedges_begin(); h != tri.halfedges_end(); ++h ) {
+		REQUIRE(h->opposite() != h);
+		REQUIRE(h->opposite()->opposite() == h);
+		REQUIRE(h->next()->prev() == h);
+		REQUIRE(h->prev()->next() == h);
+		REQUIRE(h->next()->face() == h->face());
+		REQUIRE(h->next()->opposite()->vertex() == h->vertex());
+		if( !h->is_border() ) {
+			REQUIRE(h->is_triangle());
+		}
+	}
+	for( auto v = tri.vertices_begin(); v != tri.vertices_end(); ++v ) {
+		REQUIRE(v->halfedge()->vertex() == v);
+	}
+	for( auto f = tri.faces_begin(); f != tri.faces_end(); ++f ) {
+		REQUIRE(f->halfedge()->face() == f);
+	}
+}
+
+// Flip every edge of a triangulation, in iteration order, whose
+// quadrilateral is strictly convex when it is reached, checking the
+// connectivity after each flip, and return the number of flips.
+template <class K, class Triangulation>
+std::size_t flip_convex_edges( Triangulation& tri ) {
+	K kernel;
+	kernel.configure_for_bbox(tri.max_abs_coordinate(), 1);
+	std::size_t num_flips = 0;
+	for( auto h = tri.halfedges_begin(); h != tri.halfedges_end(); ++h, ++h ) {
+		if( h->is_border_edge() ) {
+			continue;
+		}
+		if( kernel.is_strictly_convex_quad(h->vertex()->point(),
+		  h->next()->vertex()->point(), h->opposite()->vertex()->point(),
+		  h->opposite()->next()->vertex()->point()) ) {
+			REQUIRE(tri.flip_edge(h) == h);
+			check_connectivity(tri);
+			++num_flips;
+		}
+	}
+	return num_flips;
+}
+
+// Every edge of a triangulation is locally Delaunay: the vertex opposite
+// it in one face is not strictly inside the circle through the other.
+template <class K, class Triangulation>
+void check_delaunay( Triangulation& tri ) {
+	K kernel;
+	kernel.configure_for_bbox(tri.max_abs_coordinate(), 1);
+	for( auto h = tri.halfedges_begin(); h != tri.halfedges_end(); ++h, ++h ) {
+		if( h->is_border_edge() ) {
+			continue;
+		}
+		CHECK(kernel.side_of_oriented_circle(h->opposite()->vertex()->point(),
+		  h->opposite()->next()->vertex()->point(), h->vertex()->point(),
+		  h->next()->vertex()->point()) != K::Oriented_side::on_positive_side);
+	}
+}
+
+template <class K>
+void check_backends_agree( const std::string& off, double quantum,
+  bool perturb ) {
+	std::istringstream in1(off);
+	std::istringstream in2(off);
+	trilib::Triangulation_2<K> list(in1, quantum);
+	trilib::Compact_triangulation_2<K> compact(in2, quantum);
+	check_connectivity(list);
+	check_connectivity(compact);
+	REQUIRE(to_off(list) == to_off(compact));
+	CHECK(make_delaunay(list, perturb) == make_delaunay(compact, perturb));
+	check_connectivity(list);
+	check_connectivity(compact);
+	check_delaunay<K>(compact);
+	REQUIRE(to_off(list) == to_off(compact));
+}
+
+}
+
+TEST_CASE("Check both triangulation backends read the same triangulation", "[triangulation]") {
+	std::string off = grid_off(6, 0.2);
+	std::istringstream in1(off);
+	std::istringstream in2(off);
+	trilib::Triangulation_2<Kernel> list(in1);
+	trilib::Compact_triangulation_2<Kernel> compact(in2);
+	CHECK(list.size_of_vertices() == 49);
+	CHECK(compact.size_of_vertices() == 49);
+	CHECK(list.size_of_faces() == 72);
+	CHECK(compact.size_of_faces() == 72);
+	CHECK(list.size_of_edges() == compact.size_of_edges());
+	CHECK(list.max_abs_coordinate() == compact.max_abs_coordinate());
+	CHECK(to_off(list) == to_off(compact));
+}
+
+TEST_CASE("Check make_delaunay gives the same result on both backends", "[triangulation]") {
+	for( bool perturb : {false, true} ) {
+		SECTION(perturb ? "perturbed" : "preferred directions") {
+			for( unsigned seed = 0; seed < 4; ++seed ) {
+				check_backends_agree<Kernel>(grid_off(12, 0.2, seed), 0, perturb);
+			}
+			// Lattices, where nearly every quadrilateral is cocircular.
+			check_backends_agree<Kernel>(grid_off(12, 0), 0, perturb);
+			check_backends_agree<Grid_kernel>(grid_off(12, 0.2), 0.001, perturb);
+			check_backends_agree<Grid_kernel>(grid_off(12, 0), 0, perturb);
+		}
+	}
+}
+
+TEST_CASE("Check flip_edge keeps the connectivity consistent on both backends", "[triangulation]") {
+	std::string off = grid_off(10, 0.2);
+	std::istringstream in1(off);
+	std::istringstream in2(off);
+	trilib::Triangulation_2<Kernel> list(in1);
+	trilib::Compact_triangulation_2<Kernel> compact(in2);
+	std::size_t num_flips = flip_convex_edges<Kernel>(list);
+	CHECK(num_flips > 0);
+	CHECK(flip_convex_edges<Kernel>(compact) == num_flips);
+	CHECK(to_off(list) == to_off(compact));
+}
+
+TEST_CASE("Check a face degenerated by snapping is rejected", "[triangulation]") {
+	// The interior point snaps onto the bottom edge of the square.
+	std::string off = "OFF\n5 4 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n0.5 0.004 0\n"
+	  "3 0 1 4\n3 1 2 4\n3 2 3 4\n3 3 0 4\n";
+	{
+		std::istringstream in(off);
+		CHECK_THROWS_AS(trilib::Triangulation_2<Grid_kernel>(in, 0.01),
+		  std::exception);
+	}
+	{
+		std::istringstream in(off);
+		CHECK_THROWS_AS(trilib::Compact_triangulation_2<Grid_kernel>(in, 0.01),
+		  std::exception);
+	}
+	// A finer grid keeps the point off the edge.
+	std::istringstream in1(off);
+	std::istringstream in2(off);
+	trilib::Triangulation_2<Grid_kernel> list(in1, 0.001);
+	trilib::Compact_triangulation_2<Grid_kernel> compact(in2, 0.001);
+	CHECK(to_off(list) == to_off(compact));
+}
+
+TEST_CASE("Check a face with an index out of range is rejected", "[triangulation]") {
+	for( const char* index : {"4", "-1", "1000000"} ) {
+		std::string off = std::string("OFF\n4 2 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n"
+		  "3 0 1 2\n3 0 2 ") + index + "\n";
+		for( double quantum : {0.0, 0.01} ) {
+			{
+				std::istringstream in(off);
+				CHECK_THROWS_AS(trilib::Triangulation_2<Kernel>(in, quantum),
+				  std::exception);
+			}
+			{
+				std::istringstream in(off);
+				CHECK_THROWS_AS(trilib::Compact_triangulation_2<Kernel>(in, quantum),
+				  std::exception);
+			}
+		}
+	}
+}
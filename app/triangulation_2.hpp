@@ -34,11 +34,19 @@ reason, care should be taken to provide valid data to the input operation.
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <array>
+#include <iostream>
+#include <string>
 #include <set>
 #include <map>
+#include <limits>
 #include <vector>
 #include <exception>
+#include <memory>
+#include <type_traits>
 #include <CGAL/Cartesian.h>
 #include <CGAL/Filtered_kernel.h>
 #include <CGAL/HalfedgeDS_items_2.h>
@@ -57,6 +65,40 @@ namespace trilib {
 // For this reason, this code is deliberately undocumented.
 ////////////////////////////////////////////////////////////////////////////////
 
+template <class Kernel, class = void>
+struct Vertex_cache
+{
+	struct type {};
+};
+
+template <class Kernel>
+struct Vertex_cache<Kernel, std::void_t<typename Kernel::Point_cache>>
+{
+	using type = typename Kernel::Point_cache;
+};
+
+template <class Kernel, class = void>
+struct Has_orientation_batch : std::false_type {};
+
+template <class Kernel>
+struct Has_orientation_batch<Kernel, std::void_t<decltype(
+  std::declval<Kernel&>().orientation_batch(
+  std::declval<const typename Kernel::Real*>(),
+  std::declval<const typename Kernel::Real*>(),
+  std::declval<const std::size_t (*)[3]>(), std::size_t(),
+  std::declval<typename Kernel::Orientation*>()))>> : std::true_type {};
+
+template <class Kernel, class = void>
+struct Has_exact_orientation : std::false_type {};
+
+template <class Kernel>
+struct Has_exact_orientation<Kernel, std::enable_if_t<std::is_same_v<
+  decltype(std::declval<Kernel&>().orientation(
+  std::declval<const typename Kernel::Point_2&>(),
+  std::declval<const typename Kernel::Point_2&>(),
+  std::declval<const typename Kernel::Point_2&>())),
+  typename Kernel::Orientation>>> : std::true_type {};
+
 template <class Kernel>
 class Make_halfedge_data_structure
 {
@@ -65,6 +107,27 @@ private:
 	struct My_vertex : public CGAL::HalfedgeDS_vertex_base<Refs,
 	  CGAL::Tag_true, typename Traits::Point>
 	{
+		typedef CGAL::HalfedgeDS_vertex_base<Refs, CGAL::Tag_true,
+		  typename Traits::Point> Base;
+		typedef typename Vertex_cache<Kernel>::type Point_cache;
+		My_vertex() {}
+		My_vertex(const typename Traits::Point& p) : Base(p) {}
+		template <class K = Kernel, class = typename K::Point_cache>
+		Point_cache& point_cache() const
+		{
+			return cache_;
+		}
+		std::size_t id() const
+		{
+			return id_;
+		}
+		void set_id(std::size_t id)
+		{
+			id_ = id;
+		}
+	private:
+		mutable Point_cache cache_;
+		std::size_t id_ = 0;
 	};
 	template <class Refs>
 	struct My_face : public CGAL::HalfedgeDS_face_base<Refs>
@@ -122,6 +185,283 @@ public:
 	using type = CGAL::HalfedgeDS_default<My_traits, My_items>;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// Helper functions for building triangulations, shared by Triangulation_2
+// and Compact_triangulation_2 (see compact_triangulation_2.hpp).
+// This code is for internal use only and should not be used directly.
+////////////////////////////////////////////////////////////////////////////////
+
+// Get the orientation of a, b, c (1 for a left turn, -1 for a right turn
+// and 0 if collinear), exactly for the coordinate type of the kernel's
+// points.
+template <class Kernel>
+int orientation_sign(const typename Kernel::Point_2& a,
+  const typename Kernel::Point_2& b, const typename Kernel::Point_2& c)
+{
+	// A kernel with its own orientation test (ra::geometry::Kernel) decides
+	// it exactly for its coordinate type, including integers that CGAL's
+	// generic orientation test could overflow.
+	if constexpr (Has_exact_orientation<Kernel>::value) {
+		Kernel kernel;
+		return static_cast<int>(kernel.orientation(a, b, c));
+	} else {
+		return static_cast<int>(CGAL::orientation(a, b, c));
+	}
+}
+
+template <class Kernel>
+bool is_left_turn(const typename Kernel::Point_2& a,
+  const typename Kernel::Point_2& b, const typename Kernel::Point_2& c)
+{
+	return orientation_sign<Kernel>(a, b, c) > 0;
+}
+
+// Read the vertices and faces of a triangulation in OFF format, snapping
+// the vertex coordinates to a grid of spacing quantum as described for
+// Triangulation_2::input_off (quantum is set to one if it is zero and the
+// coordinates are integers). Snapping can move a vertex onto or across
+// the opposite edge of a face, so each face of a snapped triangulation is
+// checked to still be a left turn. On failure, a message is printed and
+// false is returned.
+template <class Kernel>
+bool read_off(std::istream& in, double& quantum,
+  std::vector<typename Kernel::Point_2>& points,
+  std::vector<std::array<int, 3>>& faces, double& max_abs_coordinate)
+{
+	using Point = typename Kernel::Point_2;
+	using Coordinate = std::decay_t<decltype(std::declval<const Point&>().x())>;
+	points.clear();
+	faces.clear();
+	max_abs_coordinate = 0;
+	if (quantum == 0 && std::is_integral_v<Coordinate>) {
+		quantum = 1;
+	}
+	std::string signature;
+	if (!(in >> signature) || signature != "OFF") {
+		std::cerr << "not OFF format\n";
+		return false;
+	}
+	int num_vertices;
+	int num_faces;
+	int num_edges;
+	if (!(in >> num_vertices >> num_faces >> num_edges)) {
+		std::cerr << "cannot get number of vertices/faces/edges\n";
+		return false;
+	}
+	points.reserve(std::max(num_vertices, 0));
+	for (int i = 0; i < num_vertices; ++i) {
+		double x;
+		double y;
+		double z;
+		if (!(in >> x >> y >> z)) {
+			std::cerr << "cannot get vertex\n";
+			return false;
+		}
+		if (quantum != 0) {
+			x = std::round(x / quantum);
+			y = std::round(y / quantum);
+			double max_grid_coordinate =
+			  std::numeric_limits<Coordinate>::max();
+			if (!(std::abs(x) <= max_grid_coordinate &&
+			  std::abs(y) <= max_grid_coordinate)) {
+				std::cerr << "coordinate out of range\n";
+				return false;
+			}
+		}
+		points.push_back(Point(Coordinate(x), Coordinate(y)));
+		max_abs_coordinate = std::max(max_abs_coordinate,
+		  std::max(std::abs(x), std::abs(y)));
+	}
+	faces.reserve(std::max(num_faces, 0));
+	for (int i = 0; i < num_faces; ++i) {
+		int degree;
+		std::array<int, 3> vi;
+		if (!(in >> degree >> vi[0] >> vi[1] >> vi[2])) {
+			std::cerr << "cannot get face\n";
+			return false;
+		}
+		if (degree != 3) {
+			std::cerr << "not a triangle\n";
+			return false;
+		}
+		for (int v : vi) {
+			if (v < 0 || v >= num_vertices) {
+				std::cerr << "face index out of range " << v << "\n";
+				return false;
+			}
+		}
+		if (quantum != 0 && !is_left_turn<Kernel>(points[vi[0]], points[vi[1]],
+		  points[vi[2]])) {
+			std::cerr << "face degenerated by snapping "
+			  << points[vi[0]] << " " << points[vi[1]] << " "
+			  << points[vi[2]] << "\n";
+			return false;
+		}
+		faces.push_back(vi);
+	}
+	return true;
+}
+
+// Check a triangulation whose faces have all been added (hds is the
+// halfedge data structure of Triangulation_2's Builder, or a
+// Compact_triangulation_2), linking its num_border_halfedges border
+// halfedges into the loop of the infinite face, starting from
+// border_halfedge. On failure, a message is printed for each problem
+// found and false is returned.
+template <class Kernel, class Hds, class Halfedge_handle>
+bool check_triangulation(Hds& hds, Halfedge_handle border_halfedge,
+  std::size_t num_border_halfedges)
+{
+	constexpr bool report_all = true;
+
+	bool valid = true;
+
+	// Check for any edge that has no incident faces.
+	for (auto h = hds.halfedges_begin(); h != hds.halfedges_end(); ++h, ++h) {
+		if (h->is_border() && h->opposite()->is_border()) {
+			std::cerr << "edge with no incident faces\n";
+			valid = false;
+			if (!report_all) {
+				break;
+			}
+		}
+	}
+
+	// Check for any vertex that has no incident edges.
+	if (valid) {
+		for (auto v = hds.vertices_begin(); v != hds.vertices_end(); ++v) {
+			if (v->halfedge() == Halfedge_handle()) {
+				std::cerr << "vertex with no incident edges " <<
+				  v->point() << "\n";
+				valid = false;
+				if (!report_all) {
+					break;
+				}
+			}
+		}
+	}
+
+	if (valid && num_border_halfedges == 0) {
+		std::cerr << "no border\n";
+		valid = false;
+	}
+
+	// Link the border halfedges into a loop.
+	if (valid) {
+		Halfedge_handle cur_halfedge = border_halfedge;
+		Halfedge_handle next_halfedge;
+		do {
+			Halfedge_handle h = cur_halfedge;
+			do {
+				h = h->opposite()->prev();
+			} while (!h->is_border_edge());
+			if (h == border_halfedge) {
+				// This should not happen.
+				assert(false);
+				abort();
+			}
+			next_halfedge = h->opposite();
+			next_halfedge->set_prev(cur_halfedge);
+			cur_halfedge->set_next(next_halfedge);
+			--num_border_halfedges;
+			cur_halfedge = next_halfedge;
+		} while (cur_halfedge != border_halfedge);
+		// Check for more than one bounding loop.
+		if (num_border_halfedges != 0) {
+			std::cerr << "one or more holes are present\n";
+			valid = false;
+		}
+	}
+
+	// Check orientation of finite faces.
+	// A kernel with batched orientation tests checks all faces at once,
+	// reading the corners' coordinates through their vertex ids.
+	if constexpr (Has_orientation_batch<Kernel>::value) {
+		if (valid) {
+			using Real = typename Kernel::Real;
+			std::size_t num_vertices = hds.size_of_vertices();
+			std::size_t num_faces = hds.size_of_faces();
+			std::vector<Real> x(num_vertices);
+			std::vector<Real> y(num_vertices);
+			Real max_abs_coordinate = 0;
+			for (auto v = hds.vertices_begin(); v != hds.vertices_end(); ++v) {
+				x[v->id()] = v->point().x();
+				y[v->id()] = v->point().y();
+				max_abs_coordinate = std::max(max_abs_coordinate,
+				  std::max(std::abs(x[v->id()]), std::abs(y[v->id()])));
+			}
+			std::unique_ptr<std::size_t[][3]> corners(new std::size_t[num_faces][3]);
+			std::size_t k = 0;
+			for (auto f = hds.faces_begin(); f != hds.faces_end(); ++f, ++k) {
+				Halfedge_handle halfedge = f->halfedge();
+				for (int j = 0; j < 3; ++j) {
+					corners[k][j] = halfedge->vertex()->id();
+					halfedge = halfedge->next();
+				}
+			}
+			Kernel kernel;
+			kernel.configure_for_bbox(max_abs_coordinate);
+			std::vector<typename Kernel::Orientation> orient(num_faces);
+			kernel.orientation_batch(x.data(), y.data(), corners.get(), num_faces,
+			  orient.data());
+			k = 0;
+			for (auto f = hds.faces_begin(); f != hds.faces_end(); ++f, ++k) {
+				if (orient[k] != Kernel::Orientation::left_turn) {
+					Halfedge_handle halfedge = f->halfedge();
+					std::cerr << "face has incorrect orientation "
+					  << halfedge->vertex()->point() << " "
+					  << halfedge->next()->vertex()->point() << " "
+					  << halfedge->next()->next()->vertex()->point() << " "
+					  << static_cast<int>(orient[k]) << "\n";
+					valid = false;
+					if (!report_all) {
+						break;
+					}
+				}
+			}
+		}
+	} else if (valid) {
+		int orient;
+		for (auto f = hds.faces_begin(); f != hds.faces_end(); ++f) {
+			Halfedge_handle halfedge = f->halfedge();
+			if ((orient = orientation_sign<Kernel>(halfedge->vertex()->point(),
+			  halfedge->next()->vertex()->point(),
+			  halfedge->next()->next()->vertex()->point())) <= 0) {
+				std::cerr << "face has incorrect orientation "
+				  << halfedge->vertex()->point() << " "
+				  << halfedge->next()->vertex()->point() << " "
+				  << halfedge->next()->next()->vertex()->point() << " "
+				  << orient << "\n";
+				valid = false;
+				if (!report_all) {
+					break;
+				}
+			}
+		}
+	}
+
+	// Check orientation of infinite face.
+	if (valid) {
+		Halfedge_handle cur = border_halfedge;
+		do {
+			if (is_left_turn<Kernel>(cur->prev()->vertex()->point(),
+			  cur->vertex()->point(), cur->next()->vertex()->point())) {
+				std::cerr << "border is not convex hull "
+				  << cur->prev()->vertex()->point()
+				  << " " << cur->vertex()->point()
+				  << " " << cur->next()->vertex()->point() << "\n";
+				valid = false;
+				if (!report_all) {
+					break;
+				}
+			}
+			cur = cur->next();
+		} while (cur != border_halfedge);
+	}
+
+	return valid;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // The Triangulation_2 class template.
 // A triangulation class based on a halfedge data structure.
@@ -153,6 +493,7 @@ public:
 	// For the interface provided by Vertex, see:
 	// https://doc.cgal.org/latest/Polyhedron/classCGAL_1_1Polyhedron__3_1_1Vertex.html
 	// Items of interest: point, halfedge.
+	// In addition, id gives the index of the vertex in the input.
 	using Vertex = typename HDS::Vertex;
 
 	// The mutating vertex handle type.
@@ -224,8 +565,10 @@ public:
 	either std::exception or an type derived therefrom.
 	In cases of invalid input data (not I/O errors), std::abort might be
 	called.
+	If quantum is nonzero, the vertex coordinates are snapped to a grid of
+	that spacing (see input_off).
 	*/
-	Triangulation_2(std::istream& in);
+	Triangulation_2(std::istream& in, double quantum = 0);
 
 	// The triangulation type is not movable.
 	Triangulation_2(Triangulation_2&&) = delete;
@@ -259,6 +602,21 @@ public:
 	int size_of_edges() const
 	  {return hds_.size_of_halfedges() / 2;}
 
+	/*
+	Get the largest magnitude of any vertex coordinate in the triangulation.
+	Every point in the triangulation lies in the square centered at the
+	origin with this half-width (e.g., for configuring a geometry kernel).
+	*/
+	double max_abs_coordinate() const
+	  {return max_abs_coordinate_;}
+
+	/*
+	Get the spacing of the grid to which the vertex coordinates were
+	snapped on input, or zero if they were not snapped.
+	*/
+	double quantum() const
+	  {return quantum_;}
+
 	/*
 	Get a vertex iterator that refers to the first vertex in the triangulation.
 	*/
@@ -325,14 +683,25 @@ public:
 	/*
 	Read a triangulation from an input stream in OFF format.
 	A triangulation is read in OFF format from the input stream in.
+	If quantum is nonzero, each vertex coordinate c read is snapped to the
+	nearest multiple n * quantum, and the point stores the grid coordinate
+	n (so that, for example, data in metres read with a quantum of 0.001
+	has integer coordinates in millimetres, suitable for a kernel over
+	std::int32_t); output_off scales the coordinates back by quantum.
+	Reading fails if a grid coordinate is not representable in the
+	coordinate type of the points, or if snapping leaves a face degenerate
+	or inverted (e.g., a vertex within quantum / 2 of the opposite edge of
+	its face can be snapped onto it). If the coordinate type is an integer
+	type, a quantum of zero is taken to be one.
 	Return value:
 	Upon success, true is returned; otherwise, false is returned.
 	*/
-	bool input_off(std::istream& in);
+	bool input_off(std::istream& in, double quantum = 0);
 
 	/*
 	Write a triangulation to an output stream in OFF format.
 	The triangulation is written in OFF format to the output stream out.
+	Snapped coordinates are written multiplied by quantum().
 	Return value:
 	Upon success, true is returned; otherwise, false is returned.
 	*/
@@ -343,6 +712,8 @@ private:
 	class Builder;
 	friend class Builder;
 	HDS hds_;
+	double max_abs_coordinate_;
+	double quantum_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -388,7 +759,6 @@ private:
 	typedef std::map<int, Vertex_handle> Vertex_lut;
 	typedef std::map<std::pair<Vertex_handle, Vertex_handle>, Halfedge_handle,
 	  Compare_edge> Edge_lut;
-	typedef std::vector<Face_handle> Face_list;
 	typedef std::set<Halfedge_handle> Halfedge_set;
 
 	Halfedge_handle lookup_halfedge(Vertex_handle va, Vertex_handle vb);
@@ -396,7 +766,6 @@ private:
 	int num_vertices_;
 	Vertex_lut vertex_lut_;
 	Edge_lut edge_lut_;
-	Face_list face_list_;
 	Halfedge_set border_halfedges_;
 	HDS hds_;
 
@@ -421,6 +790,7 @@ void Triangulation_2<Kernel>::Builder::add_vertex(const Point& p)
 #endif
 	Vertex v;
 	v.point() = p;
+	v.set_id(num_vertices_);
 	Vertex_handle vertex = hds_.vertices_push_back(v);
 	vertex->set_halfedge(nullptr);
 	vertex_lut_.insert(typename Vertex_lut::value_type(num_vertices_, vertex));
@@ -491,8 +861,7 @@ void Triangulation_2<Kernel>::Builder::add_face(int vai, int vbi, int vci)
 #if (TRIANGULATION_2_DEBUG_LEVEL >= 1)
 	std::cerr << "    vertices " << va->point() << " " << vb->point() << " " << vc->point() << "\n";
 #endif
-	assert(CGAL::orientation(va->point(), vb->point(), vc->point()) ==
-	  CGAL::LEFT_TURN);
+	assert(is_left_turn<Kernel>(va->point(), vb->point(), vc->point()));
 
 	Halfedge_handle ab = lookup_halfedge(va, vb);
 	Halfedge_handle bc = lookup_halfedge(vb, vc);
@@ -506,7 +875,6 @@ void Triangulation_2<Kernel>::Builder::add_face(int vai, int vbi, int vci)
 	if (ab->is_border() && bc->is_border() && ca->is_border()) {
 		Face f;
 		Face_handle face = hds_.faces_push_back(f);
-		face_list_.push_back(face);
 		assert(ab->opposite()->vertex() == va && ab->vertex() == vb);
 		ab->set_next(bc);
 		ab->set_prev(ca);
@@ -539,116 +907,10 @@ bool Triangulation_2<Kernel>::Builder::apply(Triangulation_2& tri)
 #if (TRIANGULATION_2_DEBUG_LEVEL >= 1)
 	std::cerr << "apply\n";
 #endif
-	constexpr bool report_all = true;
-
-	Halfedge_handle border_halfedge = Halfedge_handle();
-
-	bool valid = true;
-
-	// Check for any edge that has no incident faces.
-	if (valid) {
-		for (auto e = edge_lut_.begin(); e != edge_lut_.end(); ++e) {
-			if (e->second->is_border() &&
-			  e->second->opposite()->is_border()) {
-				std::cerr << "edge with no incident faces\n";
-				valid = false;
-				if (!report_all) {
-					break;
-				}
-			}
-		}
-	}
-
-	// Check for any vertex that has no incident edges.
-	if (valid) {
-		typename Vertex_lut::iterator cur;
-		typename Vertex_lut::iterator next;
-		cur = vertex_lut_.begin();
-		while (cur != vertex_lut_.end()) {
-			Vertex_handle vertex = cur->second;
-			next = cur;
-			++next;
-			if (vertex->halfedge() == Halfedge_handle()) {
-				std::cerr << "vertex with no incident edges " <<
-				  vertex->point() << "\n";
-				valid = false;
-				if (!report_all) {
-					break;
-				}
-			}
-			cur = next;
-		}
-	}
-
-	border_halfedge = *border_halfedges_.begin();
-
-	if (valid) {
-		Halfedge_handle cur_halfedge = border_halfedge;
-		Halfedge_handle next_halfedge;
-		do {
-			Halfedge_handle h = cur_halfedge;
-			do {
-				h = h->opposite()->prev();
-			} while (!h->is_border_edge());
-			if (h == border_halfedge) {
-				// This should not happen.
-				assert(false);
-				abort();
-			}
-			next_halfedge = h->opposite();
-			next_halfedge->set_prev(cur_halfedge);
-			cur_halfedge->set_next(next_halfedge);
-			border_halfedges_.erase(border_halfedges_.find(cur_halfedge));
-			cur_halfedge = next_halfedge;
-		} while (cur_halfedge != border_halfedge);
-		// Check for more than one bounding loop.
-		if (!border_halfedges_.empty()) {
-			std::cerr << "one or more holes are present\n";
-			valid = false;
-		}
-	}
-
-	// Check orientation of finite faces.
-	if (valid) {
-		CGAL::Orientation orient;
-		for (auto i = face_list_.begin(); i != face_list_.end(); ++i) {
-			Halfedge_handle halfedge = (*i)->halfedge();
-			if ((orient = CGAL::orientation(halfedge->vertex()->point(),
-			  halfedge->next()->vertex()->point(),
-			  halfedge->next()->next()->vertex()->point())) !=
-			  CGAL::LEFT_TURN) {
-				std::cerr << "face has incorrect orientation "
-				  << halfedge->vertex()->point() << " "
-				  << halfedge->next()->vertex()->point() << " "
-				  << halfedge->next()->next()->vertex()->point() << " "
-				  << orient << "\n";
-				valid = false;
-				if (!report_all) {
-					break;
-				}
-			}
-		}
-	}
-
-	// Check orientation of infinite face.
-	if (valid) {
-		Halfedge_handle cur = border_halfedge;
-		do {
-			if (CGAL::orientation(cur->prev()->vertex()->point(),
-			  cur->vertex()->point(), cur->next()->vertex()->point()) ==
-			  CGAL::LEFT_TURN) {
-				std::cerr << "border is not convex hull "
-				  << cur->prev()->vertex()->point()
-				  << " " << cur->vertex()->point()
-				  << " " << cur->next()->vertex()->point() << "\n";
-				valid = false;
-				if (!report_all) {
-					break;
-				}
-			}
-			cur = cur->next();
-		} while (cur != border_halfedge);
-	}
+	Halfedge_handle border_halfedge = border_halfedges_.empty() ?
+	  Halfedge_handle() : *border_halfedges_.begin();
+	bool valid = check_triangulation<Kernel>(hds_, border_halfedge,
+	  border_halfedges_.size());
 
 	if (valid) {
 		tri.hds_ = std::move(hds_);
@@ -662,60 +924,40 @@ bool Triangulation_2<Kernel>::Builder::apply(Triangulation_2& tri)
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename Kernel>
-Triangulation_2<Kernel>::Triangulation_2(std::istream& in)
+Triangulation_2<Kernel>::Triangulation_2(std::istream& in, double quantum)
 {
 	hds_.clear();
-	if (!input_off(in)) {
+	max_abs_coordinate_ = 0;
+	quantum_ = 0;
+	if (!input_off(in, quantum)) {
 		throw std::exception();
 	}
 }
 
 template <typename Kernel>
-bool Triangulation_2<Kernel>::input_off(std::istream& in)
+bool Triangulation_2<Kernel>::input_off(std::istream& in, double quantum)
 {
 	hds_.clear();
-	Triangulation_2::Builder builder;
-	std::string signature;
-	if (!(in >> signature) || signature != "OFF") {
-		std::cerr << "not OFF format\n";
-		return false;
-	}
-	int num_vertices;
-	int num_faces;
-	int num_edges;
-	if (!(in >> num_vertices >> num_faces >> num_edges)) {
-		std::cerr << "cannot get number of vertices/faces/edges\n";
+	max_abs_coordinate_ = 0;
+	quantum_ = 0;
+	std::vector<Point> points;
+	std::vector<std::array<int, 3>> faces;
+	double max_abs_coordinate;
+	if (!read_off<Kernel>(in, quantum, points, faces, max_abs_coordinate)) {
 		return false;
 	}
-	std::vector<Vertex_handle> v_lut;
-	for (int i = 0; i < num_vertices; ++i) {
-		Vertex v;
-		double x;
-		double y;
-		double z;
-		if (!(in >> x >> y >> z)) {
-			std::cerr << "cannot get vertex\n";
-			return false;
-		}
-		builder.add_vertex(Point(x, y));
+	Triangulation_2::Builder builder;
+	for (const Point& p : points) {
+		builder.add_vertex(p);
 	}
-	for (int i = 0; i < num_faces; ++i) {
-		Face f;
-		int degree;
-		int vi[3];
-		if (!(in >> degree >> vi[0] >> vi[1] >> vi[2])) {
-			std::cerr << "cannot get face\n";
-			return false;
-		}
-		if (degree != 3) {
-			std::cerr << "not a triangle\n";
-			return false;
-		}
+	for (const std::array<int, 3>& vi : faces) {
 		builder.add_face(vi[0], vi[1], vi[2]);
 	}
 	if (!builder.apply(*this)) {
 		return false;
 	}
+	max_abs_coordinate_ = max_abs_coordinate;
+	quantum_ = quantum;
 #if (TRIANGULATION_2_DEBUG_LEVEL >= 1)
 	std::cerr << "number of vertices " << hds_.size_of_vertices() << '\n';
 	std::cerr << "number of faces " << hds_.size_of_faces() << '\n';
@@ -735,7 +977,12 @@ bool Triangulation_2<Kernel>::output_off(std::ostream& out) const
 	for (auto vi = hds_.vertices_begin(); vi != hds_.vertices_end(); ++vi) {
 		vertex_lut[&*vi] = i;
 		++i;
-		out << vi->point().x() << " " << vi->point().y() << " 0\n";
+		if (quantum_ != 0) {
+			out << vi->point().x() * quantum_ << " "
+			  << vi->point().y() * quantum_ << " 0\n";
+		} else {
+			out << vi->point().x() << " " << vi->point().y() << " 0\n";
+		}
 	}
 	for (auto fi = hds_.faces_begin(); fi != hds_.faces_end(); ++fi) {
 		Halfedge_const_handle h = fi->halfedge();
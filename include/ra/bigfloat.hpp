@@ -0,0 +1,244 @@
+#ifndef ra_bigfloat_hpp
+#define ra_bigfloat_hpp
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace ra::math {
+
+// The limbs are multiplied in 128-bit integer arithmetic, so bigfloat is
+// only defined where the compiler provides it (see default_exact in
+// ra/kernel.hpp for the fallback).
+#if defined(__SIZEOF_INT128__)
+// An exact binary floating-point number with a mantissa of at most 64*N
+// bits, stored inline (nothing is ever allocated).
+// A value is (-1)^s * m * 2^e for an integer mantissa m, which is kept odd
+// so that it is no longer than necessary, and an unbounded (int) exponent
+// e. Sums, differences and products are exact as long as the result fits
+// in 64*N bits. A result that does not fit is flagged as overflowed (as
+// is a bigfloat constructed from a non-finite double); the flag
+// propagates through later operations, and the value of an overflowed
+// bigfloat is meaningless. A computation can therefore be checked once,
+// at its end, and redone in an unbounded number type if need be.
+template<std::size_t N>
+class bigfloat {
+	public:
+		static_assert( N >= 2 );
+
+		// The maximum number of bits in a mantissa.
+		static constexpr int max_bits = int(64 * N);
+
+		// Zero
+		bigfloat() = default;
+
+		bigfloat( int x ) : bigfloat(double(x)) {}
+
+		bigfloat( double x ) {
+			if( !std::isfinite(x) ) {
+				overflow_ = true;
+				return;
+			}
+			if( x == 0.0 ) {
+				return;
+			}
+			int e;
+			double m = std::frexp(std::abs(x), &e);
+			negative_ = x < 0.0;
+			limbs_[0] = static_cast<std::uint64_t>(std::ldexp(m, 53));
+			size_ = 1;
+			exponent_ = e - 53;
+			normalize();
+		}
+
+		bool overflow() const { return overflow_; }
+
+		int sign() const { return negative_ ? -1 : (size_ != 0); }
+
+		bigfloat operator-() const {
+			bigfloat result = *this;
+			result.negative_ = (size_ != 0) && !negative_;
+			return result;
+		}
+
+		friend bigfloat operator+( const bigfloat& a, const bigfloat& b ) {
+			return add( a, b, false );
+		}
+
+		friend bigfloat operator-( const bigfloat& a, const bigfloat& b ) {
+			return add( a, b, true );
+		}
+
+		friend bigfloat operator*( const bigfloat& a, const bigfloat& b ) {
+			bigfloat result;
+			result.overflow_ = a.overflow_ || b.overflow_;
+			if( result.overflow_ || (a.size_ == 0) || (b.size_ == 0) ) {
+				return result;
+			}
+			if( a.bit_length() + b.bit_length() > max_bits ) {
+				result.overflow_ = true;
+				return result;
+			}
+
+			// Schoolbook multiplication; the product has at most
+			// a.size_ + b.size_ limbs, the top one of which may be zero
+			std::array<std::uint64_t, 2 * N> product {};
+			for( std::size_t i = 0; i < a.size_; ++i ) {
+				std::uint64_t carry = 0;
+				for( std::size_t j = 0; j < b.size_; ++j ) {
+					wide t = wide(a.limbs_[i]) * b.limbs_[j] + product[i + j] + carry;
+					product[i + j] = static_cast<std::uint64_t>(t);
+					carry = static_cast<std::uint64_t>(t >> 64);
+				}
+				product[i + b.size_] = carry;
+			}
+			result.size_ = std::min(a.size_ + b.size_, N);
+			std::copy( product.begin(), product.begin() + result.size_, result.limbs_.begin() );
+			result.exponent_ = a.exponent_ + b.exponent_;
+			result.negative_ = a.negative_ != b.negative_;
+			result.normalize();
+			return result;
+		}
+
+		// The comparison is meaningless if the difference overflows (which
+		// it cannot when either operand is zero).
+		friend bool operator<( const bigfloat& a, const bigfloat& b ) {
+			return (a - b).sign() < 0;
+		}
+
+	private:
+		using wide = unsigned __int128;
+
+		std::array<std::uint64_t, N> limbs_ {};
+		std::size_t size_ = 0;
+		int exponent_ = 0;
+		bool negative_ = false;
+		bool overflow_ = false;
+
+		int bit_length() const {
+			if( size_ == 0 ) {
+				return 0;
+			}
+			return int(64 * size_) - __builtin_clzll(limbs_[size_ - 1]);
+		}
+
+		// Drop high zero limbs and shift out low zero bits into the
+		// exponent.
+		void normalize() {
+			while( (size_ != 0) && (limbs_[size_ - 1] == 0) ) {
+				--size_;
+			}
+			if( size_ == 0 ) {
+				exponent_ = 0;
+				negative_ = false;
+				return;
+			}
+			std::size_t low = 0;
+			while( limbs_[low] == 0 ) {
+				++low;
+			}
+			int bits = __builtin_ctzll(limbs_[low]);
+			exponent_ += int(64 * low) + bits;
+			for( std::size_t i = low; i < size_; ++i ) {
+				std::uint64_t x = limbs_[i] >> bits;
+				if( (bits != 0) && (i + 1 < size_) ) {
+					x |= limbs_[i + 1] << (64 - bits);
+				}
+				limbs_[i - low] = x;
+			}
+			size_ -= low;
+			std::fill( limbs_.begin() + size_, limbs_.end(), 0 );
+			if( limbs_[size_ - 1] == 0 ) {
+				--size_;
+			}
+		}
+
+		// Write the mantissa of x shifted left by shift bits to the first n
+		// limbs of out, which must be large enough.
+		static void shifted_mantissa( const bigfloat& x, int shift,
+		  std::array<std::uint64_t, N>& out, std::size_t n ) {
+			std::size_t q = std::size_t(shift / 64);
+			int r = shift % 64;
+			std::fill( out.begin(), out.begin() + n, 0 );
+			for( std::size_t i = 0; i < x.size_; ++i ) {
+				out[i + q] |= x.limbs_[i] << r;
+				if( (r != 0) && (i + q + 1 < n) ) {
+					out[i + q + 1] |= x.limbs_[i] >> (64 - r);
+				}
+			}
+		}
+
+		// a + b, or a - b if subtract is true.
+		static bigfloat add( const bigfloat& a, const bigfloat& b, bool subtract ) {
+			bigfloat result;
+			result.overflow_ = a.overflow_ || b.overflow_;
+			if( result.overflow_ ) {
+				return result;
+			}
+			if( b.size_ == 0 ) {
+				result = a;
+				return result;
+			}
+			if( a.size_ == 0 ) {
+				result = subtract ? -b : b;
+				return result;
+			}
+
+			// Align both mantissas to the lower exponent; the sum has one
+			// more bit than the larger of the two
+			bool b_negative = b.negative_ != subtract;
+			int exponent = std::min(a.exponent_, b.exponent_);
+			int top = std::max(a.exponent_ + a.bit_length(), b.exponent_ + b.bit_length());
+			int bits = top - exponent + 1;
+			if( bits > max_bits ) {
+				result.overflow_ = true;
+				return result;
+			}
+			std::size_t n = std::size_t((bits + 63) / 64);
+			std::array<std::uint64_t, N> x;
+			std::array<std::uint64_t, N> y;
+			shifted_mantissa( a, a.exponent_ - exponent, x, n );
+			shifted_mantissa( b, b.exponent_ - exponent, y, n );
+
+			if( a.negative_ == b_negative ) {
+				std::uint64_t carry = 0;
+				for( std::size_t i = 0; i < n; ++i ) {
+					wide t = wide(x[i]) + y[i] + carry;
+					result.limbs_[i] = static_cast<std::uint64_t>(t);
+					carry = static_cast<std::uint64_t>(t >> 64);
+				}
+				result.negative_ = a.negative_;
+			}else {
+				// Subtract the smaller magnitude from the larger
+				std::size_t i = n;
+				while( (i != 0) && (x[i - 1] == y[i - 1]) ) {
+					--i;
+				}
+				if( i == 0 ) {
+					return result;
+				}
+				bool swap = x[i - 1] < y[i - 1];
+				const std::array<std::uint64_t, N>& larger = swap ? y : x;
+				const std::array<std::uint64_t, N>& smaller = swap ? x : y;
+				std::uint64_t borrow = 0;
+				for( std::size_t j = 0; j < n; ++j ) {
+					std::uint64_t d = larger[j] - smaller[j];
+					std::uint64_t next_borrow = (larger[j] < smaller[j]) || (d < borrow);
+					result.limbs_[j] = d - borrow;
+					borrow = next_borrow;
+				}
+				result.negative_ = swap ? b_negative : a.negative_;
+			}
+			result.size_ = n;
+			result.exponent_ = exponent;
+			result.normalize();
+			return result;
+		}
+};
+#endif
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef ra_double_double_hpp
+#define ra_double_double_hpp
+
+#include "ra/expansion.hpp"
+
+namespace ra::math {
+
+// A double-double number: an unevaluated sum hi + lo of two doubles with
+// |lo| <= ulp(hi)/2, carrying about 106 bits of precision.
+// The operations are those analysed by M. Joldes, J.-M. Muller and V.
+// Popescu, "Tight and Rigorous Error Bounds for Basic Building Blocks of
+// Double-Word Arithmetic", ACM TOMS 44 (2017). With u = 2^-53, and
+// provided that the rounding mode is round-to-nearest and nothing
+// underflows or overflows:
+// - the sum or difference of two double-doubles has a relative error of
+//   at most add_error (3u^2), and is exact if both have a zero low part;
+// - the product of two double-doubles has a relative error of at most
+//   mul_error (7u^2).
+class double_double {
+	public:
+		// Relative error bounds of the operations, in units of u^2.
+		static constexpr int add_error = 3;
+		static constexpr int mul_error = 7;
+
+		// Zero
+		double_double() : hi_ {0.0}, lo_ {0.0} {}
+
+		double_double( double x ) : hi_ {x}, lo_ {0.0} {}
+
+		double hi() const { return hi_; }
+		double lo() const { return lo_; }
+
+		double_double operator-() const { return double_double(-hi_, -lo_); }
+
+		// AccurateDWPlusDW
+		friend double_double operator+( const double_double& x, const double_double& y ) {
+			double sh;
+			double sl;
+			double th;
+			double tl;
+			two_sum( x.hi_, y.hi_, sh, sl );
+			two_sum( x.lo_, y.lo_, th, tl );
+			double c = sl + th;
+			double vh;
+			double vl;
+			fast_two_sum( sh, c, vh, vl );
+			double w = tl + vl;
+			double zh;
+			double zl;
+			fast_two_sum( vh, w, zh, zl );
+			return double_double(zh, zl);
+		}
+
+		friend double_double operator-( const double_double& x, const double_double& y ) {
+			return x + (-y);
+		}
+
+		// DWTimesDW1, which needs no fused multiply-add
+		friend double_double operator*( const double_double& x, const double_double& y ) {
+			double ch;
+			double cl1;
+			two_product( x.hi_, y.hi_, ch, cl1 );
+			double tl = x.hi_ * y.lo_;
+			double tr = x.lo_ * y.hi_;
+			double cl2 = tl + tr;
+			double cl3 = cl1 + cl2;
+			double zh;
+			double zl;
+			fast_two_sum( ch, cl3, zh, zl );
+			return double_double(zh, zl);
+		}
+
+	private:
+		double_double( double hi, double lo ) : hi_ {hi}, lo_ {lo} {}
+
+		double hi_;
+		double lo_;
+};
+}
+
+#endif
@@ -0,0 +1,587 @@
+#ifndef ra_exact_predicates_hpp
+#define ra_exact_predicates_hpp
+
+#include "ra/expansion.hpp"
+#include "ra/rounding.hpp"
+#include <cfenv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Exact evaluation of the signs of the kernel's predicate determinants.
+// An exact policy (the E parameter of ra::geometry::Kernel) provides
+// static functions orientation, side_of_oriented_circle and
+// preferred_direction that take point coordinates (and the components of
+// the preferred direction) and return the exact sign (-1, 0 or 1) of the
+// corresponding determinant.
+
+namespace ra::geometry {
+
+// The determinant formulas, generic over the number type.
+template<class T>
+T orientation_determinant( const T& ax, const T& ay, const T& bx, const T& by,
+  const T& cx, const T& cy ) {
+	return ( ((ax - cx) * (by - cy)) - ((ay - cy) * (bx - cx)) );
+}
+
+template<class T>
+T side_of_oriented_circle_determinant( const T& ax, const T& ay, const T& bx,
+  const T& by, const T& cx, const T& cy, const T& dx, const T& dy ) {
+	// Translate d to the origin before lifting the points onto the
+	// paraboloid z = x^2 + y^2; the determinant is then the sum of the
+	// lifts of a, b and c times the opposite 2x2 minors. Lifting the
+	// untranslated points gives the same value, but squares coordinates
+	// that may be much larger than their differences.
+	T adx = ax - dx;
+	T ady = ay - dy;
+	T bdx = bx - dx;
+	T bdy = by - dy;
+	T cdx = cx - dx;
+	T cdy = cy - dy;
+	T alift = (adx * adx) + (ady * ady);
+	T blift = (bdx * bdx) + (bdy * bdy);
+	T clift = (cdx * cdx) + (cdy * cdy);
+	return ( (alift * ((bdx * cdy) - (cdx * bdy)))
+		+ (blift * ((cdx * ady) - (adx * cdy)))
+		+ (clift * ((adx * bdy) - (bdx * ady))) );
+}
+
+template<class T>
+T preferred_direction_determinant( const T& ax, const T& ay, const T& bx,
+  const T& by, const T& cx, const T& cy, const T& dx, const T& dy, const T& vx,
+  const T& vy ) {
+	T atob_mag2 = ((bx - ax) * (bx - ax)) + ((by - ay) * (by - ay));
+	T ctod_mag2 = ((dx - cx) * (dx - cx)) + ((dy - cy) * (dy - cy));
+
+	T atob_dotv = ((bx - ax) * vx) + ((by - ay) * vy);
+	T ctod_dotv = ((dx - cx) * vx) + ((dy - cy) * vy);
+
+	return ( (ctod_mag2 * atob_dotv * atob_dotv)
+		- (atob_mag2 * ctod_dotv * ctod_dotv) );
+}
+
+// The sign of a value of an ordered number type.
+template<class T>
+int sign_of( const T& x ) {
+	if( T(0) < x ) {
+		return 1;
+	}else if( x < T(0) ) {
+		return -1;
+	}else {
+		return 0;
+	}
+}
+
+// Exact policy evaluating the determinants in an exact number type NT
+// (e.g., CGAL::MP_Float), which must be constructible from the coordinate
+// type C.
+template<class NT>
+struct number_type_exact {
+	template<class C>
+	static int orientation( C ax, C ay, C bx, C by, C cx, C cy ) {
+		return sign_of( orientation_determinant<NT>(NT(ax), NT(ay), NT(bx), NT(by),
+		  NT(cx), NT(cy)) );
+	}
+
+	template<class C>
+	static int side_of_oriented_circle( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy ) {
+		return sign_of( side_of_oriented_circle_determinant<NT>(NT(ax), NT(ay), NT(bx),
+		  NT(by), NT(cx), NT(cy), NT(dx), NT(dy)) );
+	}
+
+	template<class C>
+	static int preferred_direction( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy,
+	  C vx, C vy ) {
+		return sign_of( preferred_direction_determinant<NT>(NT(ax), NT(ay), NT(bx),
+		  NT(by), NT(cx), NT(cy), NT(dx), NT(dy), NT(vx), NT(vy)) );
+	}
+};
+
+// Exact policy evaluating the determinants in a number type NT of bounded
+// precision, such as ra::math::bigfloat, that flags results it cannot
+// represent exactly (see bigfloat::overflow); a flagged determinant is
+// evaluated by the exact policy Fallback instead.
+template<class NT, class Fallback>
+struct bounded_number_type_exact {
+	template<class C>
+	static int orientation( C ax, C ay, C bx, C by, C cx, C cy ) {
+		NT det = orientation_determinant<NT>(NT(ax), NT(ay), NT(bx), NT(by), NT(cx), NT(cy));
+		if( det.overflow() ) {
+			return Fallback::orientation( ax, ay, bx, by, cx, cy );
+		}
+		return det.sign();
+	}
+
+	template<class C>
+	static int side_of_oriented_circle( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy ) {
+		NT det = side_of_oriented_circle_determinant<NT>(NT(ax), NT(ay), NT(bx), NT(by),
+		  NT(cx), NT(cy), NT(dx), NT(dy));
+		if( det.overflow() ) {
+			return Fallback::side_of_oriented_circle( ax, ay, bx, by, cx, cy, dx, dy );
+		}
+		return det.sign();
+	}
+
+	template<class C>
+	static int preferred_direction( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy,
+	  C vx, C vy ) {
+		NT det = preferred_direction_determinant<NT>(NT(ax), NT(ay), NT(bx), NT(by),
+		  NT(cx), NT(cy), NT(dx), NT(dy), NT(vx), NT(vy));
+		if( det.overflow() ) {
+			return Fallback::preferred_direction( ax, ay, bx, by, cx, cy, dx, dy, vx, vy );
+		}
+		return det.sign();
+	}
+};
+
+#if defined(__SIZEOF_INT128__)
+// Exact policy for signed integer coordinates of at most 32 bits,
+// evaluating the orientation and side-of-oriented-circle determinants in
+// 64- and 128-bit integer arithmetic: nothing is filtered, allocated or
+// dependent on the rounding mode, and every test costs the same. The
+// coordinate differences take 33 bits and the orientation determinant 67
+// bits; the side-of-oriented-circle determinant takes up to 133 bits, so
+// it is accumulated in two parts (see side_of_oriented_circle). The
+// preferred-direction determinant, of degree six, is handed to the exact
+// policy Fallback, with the coordinates converted (exactly) to double.
+template<class Fallback>
+class integer_exact {
+	public:
+		template<class C>
+		static int orientation( C ax, C ay, C bx, C by, C cx, C cy ) {
+			check_coordinate_type<C>();
+			std::int64_t acx = std::int64_t(ax) - cx;
+			std::int64_t acy = std::int64_t(ay) - cy;
+			std::int64_t bcx = std::int64_t(bx) - cx;
+			std::int64_t bcy = std::int64_t(by) - cy;
+			wide det = (wide(acx) * bcy) - (wide(acy) * bcx);
+			return int(det > 0) - int(det < 0);
+		}
+
+		template<class C>
+		static int side_of_oriented_circle( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy ) {
+			check_coordinate_type<C>();
+			std::int64_t adx = std::int64_t(ax) - dx;
+			std::int64_t ady = std::int64_t(ay) - dy;
+			std::int64_t bdx = std::int64_t(bx) - dx;
+			std::int64_t bdy = std::int64_t(by) - dy;
+			std::int64_t cdx = std::int64_t(cx) - dx;
+			std::int64_t cdy = std::int64_t(cy) - dy;
+
+			// The lifts are below 2^65, and the minors below 2^65 in magnitude
+			wide alift = (wide(adx) * adx) + (wide(ady) * ady);
+			wide blift = (wide(bdx) * bdx) + (wide(bdy) * bdy);
+			wide clift = (wide(cdx) * cdx) + (wide(cdy) * cdy);
+			wide bc = (wide(bdx) * cdy) - (wide(cdx) * bdy);
+			wide ca = (wide(cdx) * ady) - (wide(adx) * cdy);
+			wide ab = (wide(adx) * bdy) - (wide(bdx) * ady);
+
+			// With each lift split as hi 2^33 + lo, where 0 <= lo < 2^33, the
+			// determinant is high 2^33 + low, and both sums are below 2^100 in
+			// magnitude. Carrying all but the last 33 bits of low into high
+			// (the shift rounds toward minus infinity) leaves high 2^33 + rest
+			// with 0 <= rest < 2^33, whose sign is that of high unless high is
+			// zero
+			wide high = ((alift >> split) * bc) + ((blift >> split) * ca) + ((clift >> split) * ab);
+			wide low = ((alift & low_mask) * bc) + ((blift & low_mask) * ca)
+				+ ((clift & low_mask) * ab);
+			high += low >> split;
+			wide rest = low & low_mask;
+			return int(high > 0) - int(high < 0) + int((high == 0) & (rest != 0));
+		}
+
+		template<class C>
+		static int preferred_direction( C ax, C ay, C bx, C by, C cx, C cy, C dx, C dy,
+		  C vx, C vy ) {
+			check_coordinate_type<C>();
+			return Fallback::preferred_direction( double(ax), double(ay), double(bx),
+			  double(by), double(cx), double(cy), double(dx), double(dy), double(vx),
+			  double(vy) );
+		}
+
+	private:
+		using wide = __int128;
+
+		static constexpr int split = 33;
+		static constexpr wide low_mask = (wide(1) << split) - 1;
+
+		template<class C>
+		static void check_coordinate_type() {
+			static_assert( std::is_integral_v<C> && std::is_signed_v<C> && (sizeof(C) <= 4),
+			  "integer_exact requires signed integer coordinates of at most 32 bits" );
+		}
+};
+#endif
+
+// Exact policy for coordinates of type double (or float), evaluating the
+// determinants with floating-point expansions (see ra/expansion.hpp),
+// adaptively:
+// - The coordinate differences are computed as a rounded head and an
+//   exact tail. The determinant of the heads is evaluated exactly, and if
+//   all tails are zero (as they usually are for nearby points), or if it
+//   is far enough from zero that the tails cannot change its sign, its
+//   sign is returned.
+// - Otherwise the determinant of the exact differences is evaluated.
+// Nothing is allocated; all expansions live on the stack, with capacities
+// large enough for any input in range. Inputs out of range, where an
+// intermediate could overflow or underflow, are handed to the exact
+// policy Fallback instead.
+template<class Fallback>
+class expansion_exact {
+	public:
+		static int orientation( double ax, double ay, double bx, double by, double cx,
+		  double cy ) {
+			using namespace ra::math;
+			rounding_region region(FE_TONEAREST);
+			double p[] = {ax, ay, bx, by, cx, cy};
+			if( !pin_in_range(p) ) {
+				return fallback::orientation( ax, ay, bx, by, cx, cy );
+			}
+			ax = p[0]; ay = p[1]; bx = p[2]; by = p[3]; cx = p[4]; cy = p[5];
+
+			double acx, acxtail;
+			double acy, acytail;
+			double bcx, bcxtail;
+			double bcy, bcytail;
+			two_diff( ax, cx, acx, acxtail );
+			two_diff( ay, cy, acy, acytail );
+			two_diff( bx, cx, bcx, bcxtail );
+			two_diff( by, cy, bcy, bcytail );
+
+			// The determinant of the heads
+			expansion<2> detleft;
+			expansion<2> detright;
+			exact_product( acx, bcy, detleft );
+			exact_product( acy, bcx, detright );
+			expansion<4> det;
+			expansion_difference( detleft, detright, det );
+			if( (acxtail == 0.0) && (acytail == 0.0) && (bcxtail == 0.0) && (bcytail == 0.0) ) {
+				return signum( det.most_significant() );
+			}
+			double permanent = std::abs(acx * bcy) + std::abs(acy * bcx);
+			if( std::abs(det.most_significant()) > tail_bound(2, permanent) ) {
+				return signum( det.most_significant() );
+			}
+
+			// The determinant of the exact differences
+			expansion<2> acxe;
+			expansion<2> acye;
+			expansion<2> bcxe;
+			expansion<2> bcye;
+			exact_difference( ax, cx, acxe );
+			exact_difference( ay, cy, acye );
+			exact_difference( bx, cx, bcxe );
+			exact_difference( by, cy, bcye );
+			expansion<8> left;
+			expansion<8> right;
+			expansion_product( acxe, bcye, left );
+			expansion_product( acye, bcxe, right );
+			expansion<16> full;
+			expansion_difference( left, right, full );
+			if( !full.valid() ) {
+				return fallback::orientation( ax, ay, bx, by, cx, cy );
+			}
+			return signum( full.most_significant() );
+		}
+
+		static int side_of_oriented_circle( double ax, double ay, double bx, double by,
+		  double cx, double cy, double dx, double dy ) {
+			using namespace ra::math;
+			rounding_region region(FE_TONEAREST);
+			double p[] = {ax, ay, bx, by, cx, cy, dx, dy};
+			if( !pin_in_range(p) ) {
+				return fallback::side_of_oriented_circle( ax, ay, bx, by, cx, cy, dx, dy );
+			}
+			ax = p[0]; ay = p[1]; bx = p[2]; by = p[3];
+			cx = p[4]; cy = p[5]; dx = p[6]; dy = p[7];
+
+			// Translate d to the origin; the determinant is then the sum of
+			// the lifts of a, b and c times the opposite 2x2 minors
+			double adx, adxtail;
+			double ady, adytail;
+			double bdx, bdxtail;
+			double bdy, bdytail;
+			double cdx, cdxtail;
+			double cdy, cdytail;
+			two_diff( ax, dx, adx, adxtail );
+			two_diff( ay, dy, ady, adytail );
+			two_diff( bx, dx, bdx, bdxtail );
+			two_diff( by, dy, bdy, bdytail );
+			two_diff( cx, dx, cdx, cdxtail );
+			two_diff( cy, dy, cdy, cdytail );
+
+			// The determinant of the heads
+			expansion<96> det;
+			{
+				expansion<2> x;
+				expansion<2> y;
+				expansion<4> bc;
+				expansion<4> ca;
+				expansion<4> ab;
+				exact_product( bdx, cdy, x );
+				exact_product( cdx, bdy, y );
+				expansion_difference( x, y, bc );
+				exact_product( cdx, ady, x );
+				exact_product( adx, cdy, y );
+				expansion_difference( x, y, ca );
+				exact_product( adx, bdy, x );
+				exact_product( bdx, ady, y );
+				expansion_difference( x, y, ab );
+
+				expansion<4> alift;
+				expansion<4> blift;
+				expansion<4> clift;
+				exact_product( adx, adx, x );
+				exact_product( ady, ady, y );
+				expansion_sum( x, y, alift );
+				exact_product( bdx, bdx, x );
+				exact_product( bdy, bdy, y );
+				expansion_sum( x, y, blift );
+				exact_product( cdx, cdx, x );
+				exact_product( cdy, cdy, y );
+				expansion_sum( x, y, clift );
+
+				expansion<32> aterm;
+				expansion<32> bterm;
+				expansion<32> cterm;
+				expansion_product( bc, alift, aterm );
+				expansion_product( ca, blift, bterm );
+				expansion_product( ab, clift, cterm );
+				expansion<64> abterm;
+				expansion_sum( aterm, bterm, abterm );
+				expansion_sum( abterm, cterm, det );
+			}
+			if( (adxtail == 0.0) && (adytail == 0.0) && (bdxtail == 0.0)
+			  && (bdytail == 0.0) && (cdxtail == 0.0) && (cdytail == 0.0) ) {
+				return signum( det.most_significant() );
+			}
+			double alift = (adx * adx) + (ady * ady);
+			double blift = (bdx * bdx) + (bdy * bdy);
+			double clift = (cdx * cdx) + (cdy * cdy);
+			double permanent = ((std::abs(bdx * cdy) + std::abs(cdx * bdy)) * alift)
+				+ ((std::abs(cdx * ady) + std::abs(adx * cdy)) * blift)
+				+ ((std::abs(adx * bdy) + std::abs(bdx * ady)) * clift);
+			if( std::abs(det.most_significant()) > tail_bound(4, permanent) ) {
+				return signum( det.most_significant() );
+			}
+
+			// The determinant of the exact differences
+			expansion<2> adxe;
+			expansion<2> adye;
+			expansion<2> bdxe;
+			expansion<2> bdye;
+			expansion<2> cdxe;
+			expansion<2> cdye;
+			exact_difference( ax, dx, adxe );
+			exact_difference( ay, dy, adye );
+			exact_difference( bx, dx, bdxe );
+			exact_difference( by, dy, bdye );
+			exact_difference( cx, dx, cdxe );
+			exact_difference( cy, dy, cdye );
+
+			expansion<1536> full;
+			{
+				expansion<8> x;
+				expansion<8> y;
+				expansion<16> minor;
+				expansion<16> lift;
+				expansion<512> aterm;
+				expansion<512> bterm;
+				expansion<512> cterm;
+
+				expansion_product( bdxe, cdye, x );
+				expansion_product( cdxe, bdye, y );
+				expansion_difference( x, y, minor );
+				expansion_product( adxe, adxe, x );
+				expansion_product( adye, adye, y );
+				expansion_sum( x, y, lift );
+				expansion_product( minor, lift, aterm );
+
+				expansion_product( cdxe, adye, x );
+				expansion_product( adxe, cdye, y );
+				expansion_difference( x, y, minor );
+				expansion_product( bdxe, bdxe, x );
+				expansion_product( bdye, bdye, y );
+				expansion_sum( x, y, lift );
+				expansion_product( minor, lift, bterm );
+
+				expansion_product( adxe, bdye, x );
+				expansion_product( bdxe, adye, y );
+				expansion_difference( x, y, minor );
+				expansion_product( cdxe, cdxe, x );
+				expansion_product( cdye, cdye, y );
+				expansion_sum( x, y, lift );
+				expansion_product( minor, lift, cterm );
+
+				expansion<1024> abterm;
+				expansion_sum( aterm, bterm, abterm );
+				expansion_sum( abterm, cterm, full );
+			}
+			if( !full.valid() ) {
+				return fallback::side_of_oriented_circle( ax, ay, bx, by, cx, cy, dx, dy );
+			}
+			return signum( full.most_significant() );
+		}
+
+		static int preferred_direction( double ax, double ay, double bx, double by,
+		  double cx, double cy, double dx, double dy, double vx, double vy ) {
+			using namespace ra::math;
+			rounding_region region(FE_TONEAREST);
+			double p[] = {ax, ay, bx, by, cx, cy, dx, dy, vx, vy};
+			if( !pin_in_range(p) ) {
+				return fallback::preferred_direction( ax, ay, bx, by, cx, cy, dx, dy, vx, vy );
+			}
+			ax = p[0]; ay = p[1]; bx = p[2]; by = p[3]; cx = p[4];
+			cy = p[5]; dx = p[6]; dy = p[7]; vx = p[8]; vy = p[9];
+
+			double abx, abxtail;
+			double aby, abytail;
+			double cdx, cdxtail;
+			double cdy, cdytail;
+			two_diff( bx, ax, abx, abxtail );
+			two_diff( by, ay, aby, abytail );
+			two_diff( dx, cx, cdx, cdxtail );
+			two_diff( dy, cy, cdy, cdytail );
+
+			// The determinant of the heads
+			expansion<512> det;
+			{
+				expansion<2> x;
+				expansion<2> y;
+				expansion<4> abmag2;
+				expansion<4> cdmag2;
+				expansion<4> abdotv;
+				expansion<4> cddotv;
+				exact_product( abx, abx, x );
+				exact_product( aby, aby, y );
+				expansion_sum( x, y, abmag2 );
+				exact_product( cdx, cdx, x );
+				exact_product( cdy, cdy, y );
+				expansion_sum( x, y, cdmag2 );
+				exact_product( abx, vx, x );
+				exact_product( aby, vy, y );
+				expansion_sum( x, y, abdotv );
+				exact_product( cdx, vx, x );
+				exact_product( cdy, vy, y );
+				expansion_sum( x, y, cddotv );
+
+				expansion<32> partial;
+				expansion<256> left;
+				expansion<256> right;
+				expansion_product( cdmag2, abdotv, partial );
+				expansion_product( partial, abdotv, left );
+				expansion_product( abmag2, cddotv, partial );
+				expansion_product( partial, cddotv, right );
+				expansion_difference( left, right, det );
+			}
+			if( (abxtail == 0.0) && (abytail == 0.0) && (cdxtail == 0.0) && (cdytail == 0.0) ) {
+				return signum( det.most_significant() );
+			}
+			double abmag2 = (abx * abx) + (aby * aby);
+			double cdmag2 = (cdx * cdx) + (cdy * cdy);
+			double abdotv = std::abs(abx * vx) + std::abs(aby * vy);
+			double cddotv = std::abs(cdx * vx) + std::abs(cdy * vy);
+			double permanent = (cdmag2 * abdotv * abdotv) + (abmag2 * cddotv * cddotv);
+			if( std::abs(det.most_significant()) > tail_bound(4, permanent) ) {
+				return signum( det.most_significant() );
+			}
+
+			// The determinant of the exact differences. The structural
+			// bound on the number of components of each product of six
+			// factors is 4096, but in range no such product spans more than
+			// 1760 bits, and components do not overlap.
+			expansion<2> abxe;
+			expansion<2> abye;
+			expansion<2> cdxe;
+			expansion<2> cdye;
+			exact_difference( bx, ax, abxe );
+			exact_difference( by, ay, abye );
+			exact_difference( dx, cx, cdxe );
+			exact_difference( dy, cy, cdye );
+
+			expansion<2048> full;
+			{
+				expansion<8> x;
+				expansion<8> y;
+				expansion<16> mag2;
+				expansion<8> dotv;
+				expansion<256> partial;
+				expansion<2048> left;
+				expansion<2048> right;
+
+				expansion_product( cdxe, cdxe, x );
+				expansion_product( cdye, cdye, y );
+				expansion_sum( x, y, mag2 );
+				scale_expansion( abxe, vx, x );
+				scale_expansion( abye, vy, y );
+				expansion_sum( x, y, dotv );
+				expansion_product( mag2, dotv, partial );
+				expansion_product( partial, dotv, left );
+
+				expansion_product( abxe, abxe, x );
+				expansion_product( abye, abye, y );
+				expansion_sum( x, y, mag2 );
+				scale_expansion( cdxe, vx, x );
+				scale_expansion( cdye, vy, y );
+				expansion_sum( x, y, dotv );
+				expansion_product( mag2, dotv, partial );
+				expansion_product( partial, dotv, right );
+
+				expansion_difference( left, right, full );
+			}
+			if( !full.valid() ) {
+				return fallback::preferred_direction( ax, ay, bx, by, cx, cy, dx, dy, vx, vy );
+			}
+			return signum( full.most_significant() );
+		}
+
+	private:
+		using fallback = Fallback;
+
+		// The range of magnitudes of nonzero inputs handled with
+		// expansions. With inputs in [2^-120, 2^120], no intermediate of a
+		// determinant (of degree at most six in the inputs) overflows, and
+		// every intermediate is a multiple of 2^-1032, so none is inexact
+		// through underflow.
+		static constexpr double min_magnitude = 0x1p-120;
+		static constexpr double max_magnitude = 0x1p120;
+
+		// Pin the inputs after the change of rounding mode, and check that
+		// each is zero or in range (NaNs are not).
+		template<std::size_t N>
+		static bool pin_in_range( double (&p)[N] ) {
+			bool in_range = true;
+			for( double& x : p ) {
+				x = ra::math::force_rounding(x);
+				double m = std::abs(x);
+				if( (m != 0.0) && !((m >= min_magnitude) && (m <= max_magnitude)) ) {
+					in_range = false;
+				}
+			}
+			return in_range;
+		}
+
+		// A bound on the change in a determinant of the given degree in the
+		// coordinate differences when their heads are replaced by the exact
+		// differences, given the permanent of the determinant of the heads
+		// (the sum of the magnitudes of its terms). Each tail is at most
+		// 2^-53 times its head; the factor of two over the first-order
+		// bound covers the rounding of the permanent itself, and the
+		// difference between the most significant component of an
+		// expansion and its value.
+		static double tail_bound( int degree, double permanent ) {
+			return degree * std::numeric_limits<double>::epsilon() * permanent;
+		}
+
+		// The sign of the most significant component of a result, which is
+		// pinned before the caller's rounding mode is restored.
+		static int signum( double x ) {
+			x = ra::math::force_rounding(x);
+			return (x > 0.0) - (x < 0.0);
+		}
+};
+}
+
+#endif
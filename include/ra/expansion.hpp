@@ -0,0 +1,341 @@
+#ifndef ra_expansion_hpp
+#define ra_expansion_hpp
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+// Exact floating-point arithmetic with expansions, after J. R. Shewchuk,
+// "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates", Discrete & Computational Geometry 18 (1997).
+//
+// An expansion represents a number exactly as the sum of a sequence of
+// nonoverlapping doubles (its components) in order of increasing
+// magnitude; zero components are eliminated, so the sign of the number is
+// the sign of its last component. Every operation here is exact provided
+// that:
+// - the rounding mode is round-to-nearest (see rounding_region), and
+// - no intermediate result overflows or underflows.
+// The caller is responsible for both (e.g., by bounding the magnitudes of
+// the inputs).
+
+namespace ra::math {
+
+// x + y == a + b exactly, where x is a + b rounded.
+inline void two_sum( double a, double b, double& x, double& y ) {
+	x = a + b;
+	double bvirt = x - a;
+	double avirt = x - bvirt;
+	double bround = b - bvirt;
+	double around = a - avirt;
+	y = around + bround;
+}
+
+// As two_sum, but requires |a| >= |b| (or a == 0).
+inline void fast_two_sum( double a, double b, double& x, double& y ) {
+	x = a + b;
+	double bvirt = x - a;
+	y = b - bvirt;
+}
+
+// x + y == a - b exactly, where x is a - b rounded.
+inline void two_diff( double a, double b, double& x, double& y ) {
+	x = a - b;
+	double bvirt = a - x;
+	double avirt = x + bvirt;
+	double bround = bvirt - b;
+	double around = a - avirt;
+	y = around + bround;
+}
+
+// x + y == a * b exactly, where x is a * b rounded.
+inline void two_product( double a, double b, double& x, double& y ) {
+	x = a * b;
+#if defined(FP_FAST_FMA)
+	y = std::fma(a, b, -x);
+#else
+	// Dekker's product, splitting each factor into two 26-bit halves
+	// (Veltkamp); without a hardware FMA this is much faster than std::fma
+	constexpr double splitter = 134217729.0; // 2^27 + 1
+	double c = splitter * a;
+	double abig = c - a;
+	double ahi = c - abig;
+	double alo = a - ahi;
+	c = splitter * b;
+	double bbig = c - b;
+	double bhi = c - bbig;
+	double blo = b - bhi;
+	double err1 = x - (ahi * bhi);
+	double err2 = err1 - (alo * bhi);
+	double err3 = err2 - (ahi * blo);
+	y = (alo * blo) - err3;
+#endif
+}
+
+// The raw expansion algorithms write at most capacity components to h and
+// return the number written, or 0 if the result does not fit.
+
+// h = e + s*f, where s is 1 or -1 (Shewchuk's
+// fast_expansion_sum_zeroelim).
+inline std::size_t fast_expansion_sum_zeroelim( std::size_t elen, const double* e,
+  std::size_t flen, const double* f, double s, double* h, std::size_t capacity ) {
+	std::size_t eindex = 0;
+	std::size_t findex = 0;
+	std::size_t hindex = 0;
+	double enow = e[0];
+	double fnow = s * f[0];
+	double q;
+	double qnew;
+	double hh;
+	auto next_e = [&]() { return (++eindex < elen) ? e[eindex] : 0.0; };
+	auto next_f = [&]() { return (++findex < flen) ? s * f[findex] : 0.0; };
+	auto emit = [&]( double x ) {
+		if( x != 0.0 ) {
+			if( hindex == capacity ) {
+				return false;
+			}
+			h[hindex++] = x;
+		}
+		return true;
+	};
+
+	if( (fnow > enow) == (fnow > -enow) ) {
+		q = enow;
+		enow = next_e();
+	}else {
+		q = fnow;
+		fnow = next_f();
+	}
+	if( (eindex < elen) && (findex < flen) ) {
+		if( (fnow > enow) == (fnow > -enow) ) {
+			fast_two_sum( enow, q, qnew, hh );
+			enow = next_e();
+		}else {
+			fast_two_sum( fnow, q, qnew, hh );
+			fnow = next_f();
+		}
+		q = qnew;
+		if( !emit(hh) ) {
+			return 0;
+		}
+		while( (eindex < elen) && (findex < flen) ) {
+			if( (fnow > enow) == (fnow > -enow) ) {
+				two_sum( q, enow, qnew, hh );
+				enow = next_e();
+			}else {
+				two_sum( q, fnow, qnew, hh );
+				fnow = next_f();
+			}
+			q = qnew;
+			if( !emit(hh) ) {
+				return 0;
+			}
+		}
+	}
+	while( eindex < elen ) {
+		two_sum( q, enow, qnew, hh );
+		enow = next_e();
+		q = qnew;
+		if( !emit(hh) ) {
+			return 0;
+		}
+	}
+	while( findex < flen ) {
+		two_sum( q, fnow, qnew, hh );
+		fnow = next_f();
+		q = qnew;
+		if( !emit(hh) ) {
+			return 0;
+		}
+	}
+	if( (q != 0.0) || (hindex == 0) ) {
+		if( hindex == capacity ) {
+			return 0;
+		}
+		h[hindex++] = q;
+	}
+	return hindex;
+}
+
+// h = b*e (Shewchuk's scale_expansion_zeroelim).
+inline std::size_t scale_expansion_zeroelim( std::size_t elen, const double* e,
+  double b, double* h, std::size_t capacity ) {
+	std::size_t hindex = 0;
+	double q;
+	double hh;
+	auto emit = [&]( double x ) {
+		if( x != 0.0 ) {
+			if( hindex == capacity ) {
+				return false;
+			}
+			h[hindex++] = x;
+		}
+		return true;
+	};
+
+	two_product( e[0], b, q, hh );
+	if( !emit(hh) ) {
+		return 0;
+	}
+	for( std::size_t eindex = 1; eindex < elen; ++eindex ) {
+		double product1;
+		double product0;
+		double sum;
+		two_product( e[eindex], b, product1, product0 );
+		two_sum( q, product0, sum, hh );
+		if( !emit(hh) ) {
+			return 0;
+		}
+		fast_two_sum( product1, sum, q, hh );
+		if( !emit(hh) ) {
+			return 0;
+		}
+	}
+	if( (q != 0.0) || (hindex == 0) ) {
+		if( hindex == capacity ) {
+			return 0;
+		}
+		h[hindex++] = q;
+	}
+	return hindex;
+}
+
+// An expansion with room for at most N components.
+// An operation whose result does not fit leaves the result invalid, and
+// any operation on an invalid expansion yields an invalid expansion; so a
+// whole computation can be checked once, at its end. Capacities are
+// normally chosen so that this cannot happen.
+template<std::size_t N>
+class expansion {
+	public:
+		static constexpr std::size_t capacity = N;
+
+		// Zero
+		expansion() : size_ {1} { components_[0] = 0.0; }
+
+		explicit expansion( double a ) : size_ {1} { components_[0] = a; }
+
+		bool valid() const { return size_ != 0; }
+
+		std::size_t size() const { return size_; }
+
+		const double* data() const { return components_.data(); }
+		double* data() { return components_.data(); }
+
+		// Set the number of components, with 0 meaning invalid.
+		void set_size( std::size_t n ) {
+			assert( n <= N );
+			size_ = n;
+		}
+
+		// The largest component, which approximates the value to within
+		// a relative error of 2^-52.
+		double most_significant() const {
+			assert( valid() );
+			return components_[size_ - 1];
+		}
+
+		int sign() const {
+			double m = most_significant();
+			return (m > 0.0) - (m < 0.0);
+		}
+
+	private:
+		std::size_t size_;
+		std::array<double, N> components_;
+};
+
+// h = a + b
+template<std::size_t K>
+void exact_sum( double a, double b, expansion<K>& h ) {
+	static_assert( K >= 2 );
+	double x;
+	double y;
+	two_sum( a, b, x, y );
+	double* c = h.data();
+	std::size_t n = 0;
+	if( y != 0.0 ) {
+		c[n++] = y;
+	}
+	c[n++] = x;
+	h.set_size( n );
+}
+
+// h = a - b
+template<std::size_t K>
+void exact_difference( double a, double b, expansion<K>& h ) {
+	exact_sum( a, -b, h );
+}
+
+// h = a * b
+template<std::size_t K>
+void exact_product( double a, double b, expansion<K>& h ) {
+	static_assert( K >= 2 );
+	double x;
+	double y;
+	two_product( a, b, x, y );
+	double* c = h.data();
+	std::size_t n = 0;
+	if( y != 0.0 ) {
+		c[n++] = y;
+	}
+	c[n++] = x;
+	h.set_size( n );
+}
+
+// h = e + f
+template<std::size_t N, std::size_t M, std::size_t K>
+void expansion_sum( const expansion<N>& e, const expansion<M>& f, expansion<K>& h ) {
+	if( !e.valid() || !f.valid() ) {
+		h.set_size( 0 );
+		return;
+	}
+	h.set_size( fast_expansion_sum_zeroelim( e.size(), e.data(), f.size(), f.data(),
+	  1.0, h.data(), K ) );
+}
+
+// h = e - f
+template<std::size_t N, std::size_t M, std::size_t K>
+void expansion_difference( const expansion<N>& e, const expansion<M>& f, expansion<K>& h ) {
+	if( !e.valid() || !f.valid() ) {
+		h.set_size( 0 );
+		return;
+	}
+	h.set_size( fast_expansion_sum_zeroelim( e.size(), e.data(), f.size(), f.data(),
+	  -1.0, h.data(), K ) );
+}
+
+// h = b * e
+template<std::size_t N, std::size_t K>
+void scale_expansion( const expansion<N>& e, double b, expansion<K>& h ) {
+	if( !e.valid() ) {
+		h.set_size( 0 );
+		return;
+	}
+	h.set_size( scale_expansion_zeroelim( e.size(), e.data(), b, h.data(), K ) );
+}
+
+// h = e * f, as the sum of e scaled by each component of f.
+template<std::size_t N, std::size_t M, std::size_t K>
+void expansion_product( const expansion<N>& e, const expansion<M>& f, expansion<K>& h ) {
+	if( !e.valid() || !f.valid() ) {
+		h.set_size( 0 );
+		return;
+	}
+	scale_expansion( e, f.data()[0], h );
+	expansion<std::min(2 * N, K)> term;
+	expansion<K> partial;
+	for( std::size_t i = 1; (i < f.size()) && h.valid(); ++i ) {
+		scale_expansion( e, f.data()[i], term );
+		expansion_sum( h, term, partial );
+		h.set_size( partial.size() );
+		for( std::size_t j = 0; j < partial.size(); ++j ) {
+			h.data()[j] = partial.data()[j];
+		}
+	}
+}
+}
+
+#endif
@@ -0,0 +1,738 @@
+#ifndef ra_filters_hpp
+#define ra_filters_hpp
+
+#include "ra/double_double.hpp"
+#include "ra/exact_predicates.hpp"
+#include "ra/interval.hpp"
+#include "ra/rounding.hpp"
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// The stages of a predicate filter chain (the Filters parameters of
+// ra::geometry::Kernel).
+// A stage provides:
+// - name, a short human-readable name used in statistics;
+// - kind, the filter_kind of the stage;
+// - configure_for_bbox(max_abs_coord, max_abs_direction), which may
+//   precompute bounds for the points of a bounding box (see
+//   Kernel::configure_for_bbox), and does nothing in most stages;
+// - const member functions orientation(a, b, c),
+//   side_of_oriented_circle(a, b, c, d) and preferred_direction(a, b, c, d,
+//   v), taking points and a vector with x() and y() members, and returning
+//   the sign of the corresponding determinant as a certain_sign, or
+//   certain_sign::uncertain if the stage cannot decide it.
+// A stage may also provide orientation_batch and
+// side_of_oriented_circle_batch, evaluating many tests on points stored
+// as arrays of coordinates (see static_filter::orientation_batch); Kernel
+// uses them when the stage comes first.
+// A stage of kind exact decides every predicate; it must come last in a
+// chain, and nothing may follow it.
+
+namespace ra::geometry {
+
+// A point given by its coordinates, as the batched predicates pass the
+// points they read from arrays of coordinates to the stages.
+template<class R>
+struct plain_point {
+	R x_;
+	R y_;
+	R x() const { return x_; }
+	R y() const { return y_; }
+};
+
+// The kinds of stages.
+enum class filter_kind : int {
+	// Plain floating-point arithmetic with an error bound.
+	floating_point,
+	// Interval arithmetic.
+	interval,
+	// Double-double arithmetic with an error bound.
+	double_double,
+	// Exact arithmetic; never uncertain.
+	exact,
+};
+
+// Whether a stage F provides orientation_batch and
+// side_of_oriented_circle_batch for coordinates of type R and indices of
+// type Index.
+template<class F, class R, class Index, class = void>
+struct has_batch : std::false_type {};
+
+template<class F, class R, class Index>
+struct has_batch<F, R, Index, std::void_t<
+  decltype(std::declval<const F&>().orientation_batch(std::declval<const R*>(),
+  std::declval<const R*>(), std::declval<const Index (*)[3]>(), std::size_t(),
+  std::declval<ra::math::certain_sign*>())),
+  decltype(std::declval<const F&>().side_of_oriented_circle_batch(std::declval<const R*>(),
+  std::declval<const R*>(), std::declval<const Index (*)[4]>(), std::size_t(),
+  std::declval<ra::math::certain_sign*>()))>> : std::true_type {};
+
+// Static and semi-static filters.
+// The determinant is evaluated in plain floating-point arithmetic over R
+// and its sign is accepted when the result exceeds a forward error bound,
+// as in stage A of Shewchuk's orient2d and incircle predicates. The
+// bounds use a unit roundoff of epsilon rather than epsilon/2, so they
+// hold in any rounding mode, and carry an absolute term that covers
+// underflow (Shewchuk's bounds assume none). R must be an IEEE 754 type.
+// The semi-static bounds set by configure_for_bbox are checked first;
+// the error bound is computed per call only when that check fails. The
+// preferred-direction test is only filtered once configured.
+template<class R>
+class static_filter {
+	public:
+		static_assert( std::numeric_limits<R>::is_iec559,
+		  "static_filter requires an IEEE 754 number type" );
+
+		static constexpr const char* name = "static";
+		static constexpr filter_kind kind = filter_kind::floating_point;
+
+		// Once configured, predicates may only be applied to points whose
+		// coordinates are at most max_abs_coord in magnitude, and (for
+		// preferred_direction) to vectors whose components are at most
+		// max_abs_direction in magnitude.
+		void configure_for_bbox( R max_abs_coord, R max_abs_direction ){
+			using ra::math::add_rounded;
+			using ra::math::mul_rounded;
+
+			// Round the bounds upward; the slack covers the difference
+			// between the computed and the exact magnitudes of the terms
+			ra::math::rounding_region region;
+			R m = std::abs(max_abs_coord);
+			R v = std::abs(max_abs_direction);
+			R m2 = mul_rounded(m, m);
+			R m4 = mul_rounded(m2, m2);
+			R v2 = mul_rounded(v, v);
+			R slack = add_rounded(R(1), R(16) * epsilon);
+
+			// Each coordinate difference is at most 2m in magnitude, so
+			// the two terms of the orientation determinant sum to at most
+			// 8m^2
+			orientation_bound_ = add_rounded( mul_rounded(mul_rounded(
+			  orientation_error_bound, mul_rounded(R(8), m2)), slack), underflow_error );
+
+			// Each lift is at most 8m^2 and each 2x2 minor has terms of at
+			// most 4m^2, so the permanent is at most 3 * 8m^2 * 8m^2
+			R lift = mul_rounded(R(8), m2);
+			side_of_oriented_circle_bound_ = add_rounded( mul_rounded(mul_rounded(
+			  side_of_oriented_circle_error_bound, mul_rounded(R(192), m4)), slack),
+			  mul_rounded(underflow_error, add_rounded(lift, R(1))) );
+
+			// Each squared length is at most 8m^2 and each dot product has
+			// terms of at most 2mv, so the permanent is at most
+			// 2 * 8m^2 * (4mv)^2; an underflowing intermediate is scaled by
+			// at most 256 (1 + m)^3 (1 + v)^2
+			R one_m = add_rounded(R(1), m);
+			R one_v = add_rounded(R(1), v);
+			R scale = mul_rounded(mul_rounded(mul_rounded(R(256), one_m),
+			  mul_rounded(one_m, one_m)), mul_rounded(one_v, one_v));
+			preferred_direction_bound_ = add_rounded( mul_rounded(mul_rounded(
+			  preferred_direction_error_bound, mul_rounded(R(256), mul_rounded(m4, v2))), slack),
+			  mul_rounded(underflow_error, scale) );
+		}
+
+		template<class P>
+		ra::math::certain_sign orientation( const P& a, const P& b, const P& c ) const {
+			R acx = R(a.x()) - R(c.x());
+			R acy = R(a.y()) - R(c.y());
+			R bcx = R(b.x()) - R(c.x());
+			R bcy = R(b.y()) - R(c.y());
+			return orientation_sign( acx * bcy, acy * bcx );
+		}
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			// Translate d to the origin; the lifted points then lie on
+			// the paraboloid through the origin
+			R adx = R(a.x()) - R(d.x());
+			R ady = R(a.y()) - R(d.y());
+			R bdx = R(b.x()) - R(d.x());
+			R bdy = R(b.y()) - R(d.y());
+			R cdx = R(c.x()) - R(d.x());
+			R cdy = R(c.y()) - R(d.y());
+			return side_of_oriented_circle_sign( adx, ady, bdx, bdy, cdx, cdy, bdx * cdy,
+			  cdx * bdy, cdx * ady, adx * cdy, adx * bdy, bdx * ady );
+		}
+
+		// The signs of n orientation tests on points stored as arrays of
+		// coordinates: test k takes the points (x[i], y[i]) for the three
+		// indices i in indices[k], and its sign (or uncertain) goes to
+		// signs[k]. Each test is decided exactly as by orientation; with
+		// AVX2, four tests over double are evaluated at a time.
+		template<class Index>
+		void orientation_batch( const R* x, const R* y, const Index (*indices)[3],
+				std::size_t n, ra::math::certain_sign* signs ) const {
+			std::size_t k = 0;
+#if defined(__AVX2__)
+			if constexpr( std::is_same_v<R, double> ){
+				for( ; k + 4 <= n; k += 4 ){
+					orientation4( x, y, indices + k, signs + k );
+				}
+			}
+#endif
+			for( ; k < n; ++k ){
+				const Index* i = indices[k];
+				signs[k] = orientation( plain_point<R>{x[i[0]], y[i[0]]},
+				  plain_point<R>{x[i[1]], y[i[1]]}, plain_point<R>{x[i[2]], y[i[2]]} );
+			}
+		}
+
+		// The same for side_of_oriented_circle, with four indices per test.
+		template<class Index>
+		void side_of_oriented_circle_batch( const R* x, const R* y,
+				const Index (*indices)[4], std::size_t n,
+				ra::math::certain_sign* signs ) const {
+			std::size_t k = 0;
+#if defined(__AVX2__)
+			if constexpr( std::is_same_v<R, double> ){
+				for( ; k + 4 <= n; k += 4 ){
+					side_of_oriented_circle4( x, y, indices + k, signs + k );
+				}
+			}
+#endif
+			for( ; k < n; ++k ){
+				const Index* i = indices[k];
+				signs[k] = side_of_oriented_circle( plain_point<R>{x[i[0]], y[i[0]]},
+				  plain_point<R>{x[i[1]], y[i[1]]}, plain_point<R>{x[i[2]], y[i[2]]},
+				  plain_point<R>{x[i[3]], y[i[3]]} );
+			}
+		}
+
+		template<class P, class V>
+		ra::math::certain_sign preferred_direction( const P& a, const P& b, const P& c,
+				const P& d, const V& v ) const {
+			if( preferred_direction_bound_ == std::numeric_limits<R>::infinity() ){
+				return ra::math::certain_sign::uncertain;
+			}
+			R det = preferred_direction_determinant<R>(R(a.x()), R(a.y()), R(b.x()),
+			  R(b.y()), R(c.x()), R(c.y()), R(d.x()), R(d.y()), R(v.x()), R(v.y()));
+			return certain_sign_of(det, preferred_direction_bound_);
+		}
+
+	private:
+		static constexpr R epsilon = std::numeric_limits<R>::epsilon();
+
+		static constexpr R orientation_error_bound = (R(3) + R(16) * epsilon) * epsilon;
+
+		static constexpr R side_of_oriented_circle_error_bound = (R(10) + R(96) * epsilon) * epsilon;
+
+		// The preferred-direction determinant involves at most six rounded
+		// operations along any path.
+		static constexpr R preferred_direction_error_bound = (R(7) + R(64) * epsilon) * epsilon;
+
+		// An upper bound on the error introduced by an underflowing
+		// operation (even if subnormals are flushed to zero).
+		static constexpr R underflow_error = R(16) * std::numeric_limits<R>::min();
+
+		// The semi-static bounds; infinite until configured.
+		R orientation_bound_ = std::numeric_limits<R>::infinity();
+		R side_of_oriented_circle_bound_ = std::numeric_limits<R>::infinity();
+		R preferred_direction_bound_ = std::numeric_limits<R>::infinity();
+
+		// The orientation determinant detleft - detright, from its two
+		// products.
+		ra::math::certain_sign orientation_sign( R detleft, R detright ) const {
+			R det = detleft - detright;
+			if( std::abs(det) > orientation_bound_ ){
+				return certain_sign_of(det, R(0));
+			}
+			R detsum = std::abs(detleft) + std::abs(detright);
+			R errbound = orientation_error_bound * detsum + underflow_error;
+			return certain_sign_of(det, errbound);
+		}
+
+		// The side-of-oriented-circle determinant, from the differences
+		// a - d, b - d and c - d and the products in its 2x2 minors.
+		ra::math::certain_sign side_of_oriented_circle_sign( R adx, R ady, R bdx, R bdy,
+				R cdx, R cdy, R bdxcdy, R cdxbdy, R cdxady, R adxcdy, R adxbdy,
+				R bdxady ) const {
+			R alift = (adx * adx) + (ady * ady);
+			R blift = (bdx * bdx) + (bdy * bdy);
+			R clift = (cdx * cdx) + (cdy * cdy);
+
+			R det = (alift * (bdxcdy - cdxbdy))
+				+ (blift * (cdxady - adxcdy))
+				+ (clift * (adxbdy - bdxady));
+			if( std::abs(det) > side_of_oriented_circle_bound_ ){
+				return certain_sign_of(det, R(0));
+			}
+
+			R permanent = ((std::abs(bdxcdy) + std::abs(cdxbdy)) * alift)
+				+ ((std::abs(cdxady) + std::abs(adxcdy)) * blift)
+				+ ((std::abs(adxbdy) + std::abs(bdxady)) * clift);
+
+			// An underflowing product or lift is later scaled by at most
+			// the largest lift
+			R maxlift = std::max(std::max(alift, blift), clift);
+			R errbound = side_of_oriented_circle_error_bound * permanent
+				+ underflow_error * (maxlift + R(1));
+			return certain_sign_of(det, errbound);
+		}
+
+		// The sign of det, if det is known to within errbound. Overflow
+		// makes errbound infinite or det NaN, and so yields uncertain.
+		// Computed without branches, as the sign is often unpredictable.
+		static ra::math::certain_sign certain_sign_of( R det, R errbound ){
+			int sign = int(det > errbound) - int(-det > errbound);
+			return ra::math::certain_sign(sign + 2 * int(sign == 0));
+		}
+
+#if defined(__AVX2__)
+		// The four-lane versions of the batched tests, for R = double.
+		// Each lane performs the same operations as the scalar test, with
+		// no fused multiply-adds, so the results are identical.
+
+		// The coordinates v[indices[l][j]] of lanes l = 0, ..., 3.
+		template<class Index, std::size_t N>
+		static __m256d lanes( const double* v, const Index (*indices)[N], std::size_t j ){
+			return _mm256_set_pd( v[indices[3][j]], v[indices[2][j]], v[indices[1][j]],
+			  v[indices[0][j]] );
+		}
+
+		static __m256d abs4( __m256d v ){
+			return _mm256_andnot_pd( _mm256_set1_pd(-0.0), v );
+		}
+
+		// The signs of det in each lane, if det is known to within
+		// errbound or to within the semi-static bound, as by the scalar
+		// orientation_sign and side_of_oriented_circle_sign.
+		static void certain_signs_of( __m256d det, __m256d errbound, R bound,
+				ra::math::certain_sign* signs ){
+			__m256d semi = _mm256_set1_pd(bound);
+			__m256d negdet = _mm256_xor_pd( det, _mm256_set1_pd(-0.0) );
+			int positive = _mm256_movemask_pd( _mm256_or_pd(
+			  _mm256_cmp_pd(det, semi, _CMP_GT_OQ), _mm256_cmp_pd(det, errbound, _CMP_GT_OQ)) );
+			int negative = _mm256_movemask_pd( _mm256_or_pd(
+			  _mm256_cmp_pd(negdet, semi, _CMP_GT_OQ),
+			  _mm256_cmp_pd(negdet, errbound, _CMP_GT_OQ)) );
+			for( int l = 0; l < 4; ++l ){
+				int sign = ((positive >> l) & 1) - ((negative >> l) & 1);
+				signs[l] = ra::math::certain_sign(sign + 2 * int(sign == 0));
+			}
+		}
+
+		template<class Index>
+		void orientation4( const double* x, const double* y, const Index (*indices)[3],
+				ra::math::certain_sign* signs ) const {
+			__m256d cx = lanes(x, indices, 2);
+			__m256d cy = lanes(y, indices, 2);
+			__m256d acx = _mm256_sub_pd( lanes(x, indices, 0), cx );
+			__m256d acy = _mm256_sub_pd( lanes(y, indices, 0), cy );
+			__m256d bcx = _mm256_sub_pd( lanes(x, indices, 1), cx );
+			__m256d bcy = _mm256_sub_pd( lanes(y, indices, 1), cy );
+			__m256d detleft = _mm256_mul_pd( acx, bcy );
+			__m256d detright = _mm256_mul_pd( acy, bcx );
+			__m256d det = _mm256_sub_pd( detleft, detright );
+			__m256d detsum = _mm256_add_pd( abs4(detleft), abs4(detright) );
+			__m256d errbound = _mm256_add_pd( _mm256_mul_pd(
+			  _mm256_set1_pd(orientation_error_bound), detsum ),
+			  _mm256_set1_pd(underflow_error) );
+			certain_signs_of( det, errbound, orientation_bound_, signs );
+		}
+
+		template<class Index>
+		void side_of_oriented_circle4( const double* x, const double* y,
+				const Index (*indices)[4], ra::math::certain_sign* signs ) const {
+			__m256d dx = lanes(x, indices, 3);
+			__m256d dy = lanes(y, indices, 3);
+			__m256d adx = _mm256_sub_pd( lanes(x, indices, 0), dx );
+			__m256d ady = _mm256_sub_pd( lanes(y, indices, 0), dy );
+			__m256d bdx = _mm256_sub_pd( lanes(x, indices, 1), dx );
+			__m256d bdy = _mm256_sub_pd( lanes(y, indices, 1), dy );
+			__m256d cdx = _mm256_sub_pd( lanes(x, indices, 2), dx );
+			__m256d cdy = _mm256_sub_pd( lanes(y, indices, 2), dy );
+
+			__m256d bdxcdy = _mm256_mul_pd( bdx, cdy );
+			__m256d cdxbdy = _mm256_mul_pd( cdx, bdy );
+			__m256d cdxady = _mm256_mul_pd( cdx, ady );
+			__m256d adxcdy = _mm256_mul_pd( adx, cdy );
+			__m256d adxbdy = _mm256_mul_pd( adx, bdy );
+			__m256d bdxady = _mm256_mul_pd( bdx, ady );
+
+			__m256d alift = _mm256_add_pd( _mm256_mul_pd(adx, adx), _mm256_mul_pd(ady, ady) );
+			__m256d blift = _mm256_add_pd( _mm256_mul_pd(bdx, bdx), _mm256_mul_pd(bdy, bdy) );
+			__m256d clift = _mm256_add_pd( _mm256_mul_pd(cdx, cdx), _mm256_mul_pd(cdy, cdy) );
+
+			__m256d det = _mm256_add_pd( _mm256_add_pd(
+			  _mm256_mul_pd( alift, _mm256_sub_pd(bdxcdy, cdxbdy) ),
+			  _mm256_mul_pd( blift, _mm256_sub_pd(cdxady, adxcdy) )),
+			  _mm256_mul_pd( clift, _mm256_sub_pd(adxbdy, bdxady) ) );
+
+			__m256d permanent = _mm256_add_pd( _mm256_add_pd(
+			  _mm256_mul_pd( _mm256_add_pd(abs4(bdxcdy), abs4(cdxbdy)), alift ),
+			  _mm256_mul_pd( _mm256_add_pd(abs4(cdxady), abs4(adxcdy)), blift )),
+			  _mm256_mul_pd( _mm256_add_pd(abs4(adxbdy), abs4(bdxady)), clift ) );
+			__m256d maxlift = _mm256_max_pd( _mm256_max_pd(alift, blift), clift );
+			__m256d errbound = _mm256_add_pd( _mm256_mul_pd(
+			  _mm256_set1_pd(side_of_oriented_circle_error_bound), permanent ),
+			  _mm256_mul_pd( _mm256_set1_pd(underflow_error),
+			  _mm256_add_pd(maxlift, _mm256_set1_pd(1.0)) ) );
+			certain_signs_of( det, errbound, side_of_oriented_circle_bound_, signs );
+		}
+#endif
+};
+
+// Filter for coordinates of type float, evaluated in double.
+// A product of two floats is exact in double, so the orientation
+// determinant of float points, expanded as the sum of the cross products
+// a x b + b x c + c x a, is a sum of six exact doubles. The stage sums
+// them into a fixed six-component expansion whenever the static filter
+// over double leaves the sign uncertain, so it decides every orientation
+// test without falling back on a later stage. The side-of-oriented-circle
+// test is filtered first in float, as by static_filter<float>, which
+// decides most tests as cheaply, and only then in double; the error
+// bounds in double are some 2^29 times tighter, so only nearly degenerate
+// tests go on to the later stages. The preferred-direction test is
+// filtered in double.
+class float_filter {
+	public:
+		static constexpr const char* name = "float";
+		static constexpr filter_kind kind = filter_kind::floating_point;
+
+		template<class T>
+		void configure_for_bbox( T max_abs_coord, T max_abs_direction ){
+			promoted_.configure_for_bbox( double(max_abs_coord), double(max_abs_direction) );
+			native_.configure_for_bbox( float_above(max_abs_coord),
+			  float_above(max_abs_direction) );
+		}
+
+		template<class P>
+		ra::math::certain_sign orientation( const P& a, const P& b, const P& c ) const {
+			check_coordinates(a);
+			ra::math::certain_sign sign = promoted_.orientation( a, b, c );
+			if( sign != ra::math::certain_sign::uncertain ){
+				return sign;
+			}
+			return exact_orientation( a, b, c );
+		}
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			check_coordinates(a);
+			ra::math::certain_sign sign = native_.side_of_oriented_circle( a, b, c, d );
+			if( sign != ra::math::certain_sign::uncertain ){
+				return sign;
+			}
+			return promoted_.side_of_oriented_circle( a, b, c, d );
+		}
+
+		template<class P, class V>
+		ra::math::certain_sign preferred_direction( const P& a, const P& b, const P& c,
+				const P& d, const V& v ) const {
+			check_coordinates(a);
+			return promoted_.preferred_direction( a, b, c, d, v );
+		}
+
+	private:
+		static_filter<float> native_;
+		static_filter<double> promoted_;
+
+		// The magnitude of x, as a float no smaller than it.
+		template<class T>
+		static float float_above( T x ){
+			double magnitude = std::abs(double(x));
+			float result = float(magnitude);
+			if( double(result) < magnitude ){
+				result = std::nextafter(result, std::numeric_limits<float>::infinity());
+			}
+			return result;
+		}
+
+		// Coordinates of type double would be rounded by the products.
+		template<class P>
+		static void check_coordinates( const P& a ){
+			static_assert( std::is_same_v<std::decay_t<decltype(a.x())>, float>,
+			  "float_filter requires float coordinates" );
+		}
+
+		// The exact sign of the orientation determinant. The products
+		// are exact in any rounding mode, and do not underflow (the
+		// smallest is 2^-298) or overflow (the largest is below 2^256);
+		// the sums are exact in round-to-nearest. Infinite or NaN
+		// coordinates are not supported.
+		template<class P>
+		static ra::math::certain_sign exact_orientation( const P& a, const P& b,
+				const P& c ){
+			using ra::math::force_rounding;
+			double ax = a.x();
+			double ay = a.y();
+			double bx = b.x();
+			double by = b.y();
+			double cx = c.x();
+			double cy = c.y();
+			double products[] = {ax * by, ay * bx, bx * cy, by * cx, cx * ay, cy * ax};
+
+			ra::math::rounding_region region(FE_TONEAREST);
+			for( double& p : products ){
+				p = force_rounding(p);
+			}
+
+			// Each cross product as a two-component expansion, then
+			// their sum
+			double h[6];
+			double f[2];
+			double g[2];
+			ra::math::two_diff( products[0], products[1], h[1], h[0] );
+			ra::math::two_diff( products[2], products[3], f[1], f[0] );
+			ra::math::two_diff( products[4], products[5], g[1], g[0] );
+			expansion_sum( h, 2, f, 2 );
+			expansion_sum( h, 4, g, 2 );
+
+			// The components are nonoverlapping and in increasing order
+			// of magnitude, apart from zeros; the sign is that of the
+			// last nonzero one
+			int sign = 0;
+			for( double x : h ){
+				x = force_rounding(x);
+				sign = (x != 0.0) ? int(x > 0.0) - int(x < 0.0) : sign;
+			}
+			return ra::math::certain_sign(sign);
+		}
+
+		// h[0, m + n) = h[0, m) + f[0, n), where both are expansions
+		// (Shewchuk's expansion_sum). Zero components are kept, so there
+		// are no data-dependent branches.
+		static void expansion_sum( double* h, std::size_t m, const double* f, std::size_t n ){
+			for( std::size_t i = 0; i < n; ++i ){
+				double q = f[i];
+				for( std::size_t j = i; j < m + i; ++j ){
+					ra::math::two_sum( h[j], q, q, h[j] );
+				}
+				h[m + i] = q;
+			}
+		}
+};
+
+// Interval filter.
+// The determinant is evaluated in the interval type I, with the rounding
+// mode set once for the whole evaluation; I should therefore use the
+// protected_rounding policy (any storage policy may be used).
+template<class I>
+class interval_filter {
+	public:
+		static constexpr const char* name = "interval";
+		static constexpr filter_kind kind = filter_kind::interval;
+
+		template<class T>
+		void configure_for_bbox( T, T ){}
+
+		template<class P>
+		ra::math::certain_sign orientation( const P& a, const P& b, const P& c ) const {
+			ra::math::rounding_region region;
+			return orientation_determinant<I>(I(a.x()), I(a.y()), I(b.x()), I(b.y()),
+			  I(c.x()), I(c.y())).sign_or_uncertain();
+		}
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			ra::math::rounding_region region;
+			return side_of_oriented_circle_determinant<I>(I(a.x()), I(a.y()), I(b.x()),
+			  I(b.y()), I(c.x()), I(c.y()), I(d.x()), I(d.y())).sign_or_uncertain();
+		}
+
+		template<class P, class V>
+		ra::math::certain_sign preferred_direction( const P& a, const P& b, const P& c,
+				const P& d, const V& v ) const {
+			ra::math::rounding_region region;
+			return preferred_direction_determinant<I>(I(a.x()), I(a.y()), I(b.x()),
+			  I(b.y()), I(c.x()), I(c.y()), I(d.x()), I(d.y()), I(v.x()),
+			  I(v.y())).sign_or_uncertain();
+		}
+};
+
+// Double-double filter, for coordinates of type float or double.
+// The coordinate differences are computed exactly as double-doubles, and
+// the determinant is evaluated from them in double-double arithmetic. Its
+// sign is accepted when the result exceeds an a priori bound of c u^2
+// times the permanent of the determinant (u = 2^-53), where c sums the
+// relative error bounds of the double-double operations (see
+// ra/double_double.hpp) along any path through the evaluation, with some
+// slack for the rounding of the permanent. The stage is uncertain unless
+// every coordinate is zero or between 2^-100 and 2^100 in magnitude, so
+// that no intermediate underflows or overflows.
+class double_double_filter {
+	public:
+		static constexpr const char* name = "double-double";
+		static constexpr filter_kind kind = filter_kind::double_double;
+
+		template<class T>
+		void configure_for_bbox( T, T ){}
+
+		template<class P>
+		ra::math::certain_sign orientation( const P& a, const P& b, const P& c ) const {
+			check_coordinates(a);
+			using DD = ra::math::double_double;
+			ra::math::rounding_region region(FE_TONEAREST);
+			double p[] = {double(a.x()), double(a.y()), double(b.x()), double(b.y()),
+			  double(c.x()), double(c.y())};
+			if( !pin_in_range(p) ){
+				return ra::math::certain_sign::uncertain;
+			}
+			DD det = orientation_determinant<DD>(p[0], p[1], p[2], p[3], p[4], p[5]);
+			double permanent = std::abs((p[0] - p[4]) * (p[3] - p[5]))
+				+ std::abs((p[1] - p[5]) * (p[2] - p[4]));
+			return sign_of(det.hi(), orientation_error_bound * permanent);
+		}
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			check_coordinates(a);
+			using DD = ra::math::double_double;
+			ra::math::rounding_region region(FE_TONEAREST);
+			double p[] = {double(a.x()), double(a.y()), double(b.x()), double(b.y()),
+			  double(c.x()), double(c.y()), double(d.x()), double(d.y())};
+			if( !pin_in_range(p) ){
+				return ra::math::certain_sign::uncertain;
+			}
+
+			// Translate d to the origin, as in the static filter; the
+			// differences are exact
+			DD adx = DD(p[0]) - DD(p[6]);
+			DD ady = DD(p[1]) - DD(p[7]);
+			DD bdx = DD(p[2]) - DD(p[6]);
+			DD bdy = DD(p[3]) - DD(p[7]);
+			DD cdx = DD(p[4]) - DD(p[6]);
+			DD cdy = DD(p[5]) - DD(p[7]);
+
+			DD alift = (adx * adx) + (ady * ady);
+			DD blift = (bdx * bdx) + (bdy * bdy);
+			DD clift = (cdx * cdx) + (cdy * cdy);
+			DD det = (alift * ((bdx * cdy) - (cdx * bdy)))
+				+ (blift * ((cdx * ady) - (adx * cdy)))
+				+ (clift * ((adx * bdy) - (bdx * ady)));
+
+			double permanent = ((std::abs(bdx.hi() * cdy.hi()) + std::abs(cdx.hi() * bdy.hi()))
+				  * alift.hi())
+				+ ((std::abs(cdx.hi() * ady.hi()) + std::abs(adx.hi() * cdy.hi())) * blift.hi())
+				+ ((std::abs(adx.hi() * bdy.hi()) + std::abs(bdx.hi() * ady.hi())) * clift.hi());
+			return sign_of(det.hi(), side_of_oriented_circle_error_bound * permanent);
+		}
+
+		template<class P, class V>
+		ra::math::certain_sign preferred_direction( const P& a, const P& b, const P& c,
+				const P& d, const V& v ) const {
+			check_coordinates(a);
+			using DD = ra::math::double_double;
+			ra::math::rounding_region region(FE_TONEAREST);
+			double p[] = {double(a.x()), double(a.y()), double(b.x()), double(b.y()),
+			  double(c.x()), double(c.y()), double(d.x()), double(d.y()), double(v.x()),
+			  double(v.y())};
+			if( !pin_in_range(p) ){
+				return ra::math::certain_sign::uncertain;
+			}
+			DD det = preferred_direction_determinant<DD>(p[0], p[1], p[2], p[3], p[4], p[5],
+			  p[6], p[7], p[8], p[9]);
+
+			double abx = p[2] - p[0];
+			double aby = p[3] - p[1];
+			double cdx = p[6] - p[4];
+			double cdy = p[7] - p[5];
+			double abmag2 = (abx * abx) + (aby * aby);
+			double cdmag2 = (cdx * cdx) + (cdy * cdy);
+			double abdotv = std::abs(abx * p[8]) + std::abs(aby * p[9]);
+			double cddotv = std::abs(cdx * p[8]) + std::abs(cdy * p[9]);
+			double permanent = (cdmag2 * abdotv * abdotv) + (abmag2 * cddotv * cddotv);
+			return sign_of(det.hi(), preferred_direction_error_bound * permanent);
+		}
+
+	private:
+		static constexpr double unit_roundoff_squared = 0x1p-106;
+
+		// Products cost mul_error, and sums and differences add_error, on
+		// top of the errors of their operands: 10 for the orientation
+		// determinant, 33 for side-of-oriented-circle (lifts and minors
+		// cost 10 each) and 47 for preferred-direction (squared lengths and
+		// dot products cost 10 each, and each term takes two products).
+		static constexpr double orientation_error_bound = 12 * unit_roundoff_squared;
+
+		static constexpr double side_of_oriented_circle_error_bound = 36 * unit_roundoff_squared;
+
+		static constexpr double preferred_direction_error_bound = 50 * unit_roundoff_squared;
+
+		// Coordinates of any other type would be rounded on conversion.
+		template<class P>
+		static void check_coordinates( const P& a ){
+			using C = std::decay_t<decltype(a.x())>;
+			static_assert( std::is_same_v<C, float> || std::is_same_v<C, double>,
+			  "double_double_filter requires float or double coordinates" );
+		}
+
+		// Pin the coordinates after the change of rounding mode, and check
+		// that each is zero or in range (NaNs are not).
+		template<std::size_t N>
+		static bool pin_in_range( double (&p)[N] ){
+			bool in_range = true;
+			for( double& x : p ){
+				x = ra::math::force_rounding(x);
+				double m = std::abs(x);
+				if( (m != 0.0) && !((m >= 0x1p-100) && (m <= 0x1p100)) ){
+					in_range = false;
+				}
+			}
+			return in_range;
+		}
+
+		// Both det and errbound are pinned before the caller's rounding
+		// mode is restored.
+		static ra::math::certain_sign sign_of( double det, double errbound ){
+			det = ra::math::force_rounding(det);
+			errbound = ra::math::force_rounding(errbound);
+			if( det > errbound ){
+				return ra::math::certain_sign::positive;
+			}else if( -det > errbound ){
+				return ra::math::certain_sign::negative;
+			}else{
+				return ra::math::certain_sign::uncertain;
+			}
+		}
+};
+
+// Exact stage, deciding every predicate with the exact policy E (see
+// ra/exact_predicates.hpp).
+template<class E>
+class exact_filter {
+	public:
+		static constexpr const char* name = "exact";
+		static constexpr filter_kind kind = filter_kind::exact;
+
+		template<class T>
+		void configure_for_bbox( T, T ){}
+
+		template<class P>
+		ra::math::certain_sign orientation( const P& a, const P& b, const P& c ) const {
+			using C = std::decay_t<decltype(a.x())>;
+			return ra::math::certain_sign(E::orientation(C(a.x()), C(a.y()), C(b.x()),
+			  C(b.y()), C(c.x()), C(c.y())));
+		}
+
+		template<class P>
+		ra::math::certain_sign side_of_oriented_circle( const P& a, const P& b, const P& c,
+				const P& d ) const {
+			using C = std::decay_t<decltype(a.x())>;
+			return ra::math::certain_sign(E::side_of_oriented_circle(C(a.x()), C(a.y()),
+			  C(b.x()), C(b.y()), C(c.x()), C(c.y()), C(d.x()), C(d.y())));
+		}
+
+		template<class P, class V>
+		ra::math::certain_sign preferred_direction( const P& a, const P& b, const P& c,
+				const P& d, const V& v ) const {
+			using C = std::decay_t<decltype(a.x())>;
+			return ra::math::certain_sign(E::preferred_direction(C(a.x()), C(a.y()),
+			  C(b.x()), C(b.y()), C(c.x()), C(c.y()), C(d.x()), C(d.y()), C(v.x()),
+			  C(v.y())));
+		}
+};
+}
+
+#endif
@@ -1,7 +1,25 @@
+#ifndef ra_interval_hpp
+#define ra_interval_hpp
+
+#include "ra/rounding.hpp"
+#include "ra/statistics.hpp"
 #include <stdexcept>
 #include <cfenv>
 #include <cassert>
 #include <iostream>
+#include <type_traits>
+
+// Select the interval multiplication algorithm at compile time:
+// 0 classifies the operand signs and computes two products (the default);
+// 1 computes all four products and takes their minimum and maximum.
+// Which is faster depends on the CPU and the data; see bench_interval.
+// The branchless version is only used where the endpoint products do not
+// each change the rounding mode (i.e., not with checked_rounding and
+// endpoint_storage, for which it is much slower), so the lookup version
+// is always used there.
+#ifndef RA_INTERVAL_BRANCHLESS_MUL
+#define RA_INTERVAL_BRANCHLESS_MUL 0
+#endif
 
 namespace ra::math{
 struct indeterminate_result : public std::runtime_error
@@ -9,11 +27,25 @@ struct indeterminate_result : public std::runtime_error
 	using std::runtime_error::runtime_error;
 };
 
-template<typename T>
-class interval {
-	public:
-		using real_type = T;
+// The sign of an interval, if it can be determined.
+// The enumerators other than uncertain have the values returned by
+// interval::sign.
+enum class certain_sign : int {
+	negative = -1,
+	zero = 0,
+	positive = 1,
+	// The interval contains zero and at least one nonzero value.
+	uncertain = 2,
+};
 
+// The statistics kept for an interval type.
+// Every interval type (i.e., every combination of real type and policies)
+// has its own set of statistics. Each thread counts separately;
+// get_statistics reports the totals over all threads and
+// get_thread_statistics the counts of the calling thread.
+template<class Interval>
+class interval_statistics {
+	public:
 		struct statistics {
 			// The total number of inderterminate results encountered.
 			unsigned long indeterminate_result_count;
@@ -21,216 +53,166 @@ class interval {
 			unsigned long arithmetic_op_count;
 		};
 
-		//Default constructor
-		interval( real_type init = real_type(0) ) : lower_ {init}, upper_ {init} {};
+		static void clear_statistics() { counters::clear(); }
 
-		//Two argument constructor
-		interval( real_type bot, real_type top ) : lower_ {bot}, upper_ {top} {
-			assert( lower_ <= upper_ );
+		static void get_statistics( statistics& stat ) {
+			typename counters::counts counts;
+			counters::merged( counts );
+			stat = to_statistics( counts );
 		}
 
-		interval& operator +=( interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
+		static void get_thread_statistics( statistics& stat ) {
+			typename counters::counts counts;
+			counters::thread_local_counts( counts );
+			stat = to_statistics( counts );
+		}
 
-			// Capture values to prevent aliasing
-			real_type this_lower = lower();
-			real_type this_upper = upper();
-			real_type other_lower = other.lower();
-			real_type other_upper = other.upper();
+		static void record_indeterminate_result() {
+#if RA_GEOMETRY_STATS
+			counters::increment( indeterminate_result );
+#endif
+		}
+		static void record_arithmetic_op() {
+#if RA_GEOMETRY_STATS
+			counters::increment( arithmetic_op );
+#endif
+		}
 
-			// Perform calculations with appropriate rounding modes
-			set_round_down();
-			lower_ = this_lower + other_lower;
-			set_round_up();
-			upper_ = this_upper + other_upper;
+	private:
+		enum counter { indeterminate_result, arithmetic_op, num_counters };
 
-			// Record arithmetic operation
-			record_arithmetic_op();
+		using counters = counter_registry<Interval, num_counters>;
 
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
-			return *this;
+		static statistics to_statistics( const typename counters::counts& counts ) {
+			return statistics {counts[indeterminate_result], counts[arithmetic_op]};
 		}
+};
 
-		interval& operator -=( interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
+// Storage policies for interval.
+
+// The bounds are stored as they are. Lower bounds are computed with
+// downward rounding and upper bounds with upward rounding.
+struct endpoint_storage {};
+
+// The bounds are stored as the negated lower bound and the upper bound.
+// Both stored quantities are then computed with upward rounding, so an
+// operation never has to switch between rounding modes.
+struct negated_lower_storage {};
+
+// An interval of real numbers.
+// The rounding policy determines how the directed rounding needed for the
+// bounds is obtained (see ra/rounding.hpp). With the default policy every
+// operation is self-contained; with protected_rounding the operations must
+// be performed inside a rounding_region. The storage policy determines the
+// representation of the bounds; it does not affect the results.
+template<typename T, class Rounding = checked_rounding<T>,
+  class Storage = endpoint_storage>
+class interval : public interval_statistics<interval<T, Rounding, Storage>> {
+	public:
+		using real_type = T;
 
-			// Capture values to prevent aliasing
-			real_type this_lower = lower();
-			real_type this_upper = upper();
-			real_type other_lower = other.lower();
-			real_type other_upper = other.upper();
+		using rounding_policy = Rounding;
 
-			// Perform calculations with appropriate rounding modes
-			set_round_down();
-			lower_ = this_lower - other_upper;
-			set_round_up();
-			upper_ = this_upper - other_lower;
+		using storage_policy = Storage;
 
-			// Record arithmetic operation
-			record_arithmetic_op();
+		using typename interval_statistics<interval>::statistics;
+		using interval_statistics<interval>::clear_statistics;
+		using interval_statistics<interval>::get_statistics;
+		using interval_statistics<interval>::get_thread_statistics;
+		using interval_statistics<interval>::record_indeterminate_result;
+		using interval_statistics<interval>::record_arithmetic_op;
 
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
-			return *this;
-		}
+		//Default constructor
+		interval( real_type init = real_type(0) ) : lower_ {stored_lower(init)}, upper_ {init} {};
 
-		interval& operator *=( interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
+		//Two argument constructor
+		interval( real_type bot, real_type top ) : lower_ {stored_lower(bot)}, upper_ {top} {
+			assert( lower() <= upper() );
+		}
 
-			// Capture values to prevent aliasing
-			real_type this_lower = lower();
-			real_type this_upper = upper();
-			real_type other_lower = other.lower();
-			real_type other_upper = other.upper();
+		interval& operator +=( const interval& other ) {
+			if constexpr( negated_lower ) {
+				// Hold users rounding mode; round upward throughout
+				[[maybe_unused]] typename Rounding::upward_guard rounding_guard;
 
-			// Create 8-bit lookup table for upcoming switch
-			char lookup = get_mul_lookup_table_for( other );
+				// -(a + b) == (-a) + (-b), so both bounds are sums
+				lower_ = add_rounded(lower_, other.lower_);
+				upper_ = add_rounded(upper_, other.upper_);
 
-			// Perform calculations with appropriate rounding modes
-			switch( lookup ) {
-				case (char)0x11:
-					// both negative
-					//std::cout << *this << '\n' << other << '\n' << "both negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_upper;
-					set_round_up();
-					upper_ = this_lower * other_lower;
-					break;
-				case (char)0x21:
-					// this negative other both
-					//std::cout << *this << '\n' << other << '\n' << "this negative other both" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_lower * other_lower;
-					break;
-				case (char)0x41:
-					// this negative other positive
-					//std::cout << *this << '\n' << other << '\n' << "this negative other positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_upper * other_lower;
-					break;
-				case (char)0x12:
-					// this both other negative
-					//std::cout << *this << '\n' << other << '\n' << "this both other negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_lower * other_lower;
-					break;
-				case (char)0x22:
-					// both both
-					//std::cout << *this << '\n' << other << '\n' << "both both" << "\n\n";
-					set_round_down();
-					lower_ = (this_lower * other_upper < this_upper * other_lower) ? (this_lower * other_upper) : (this_upper * other_lower);
-					set_round_up();
-					upper_ = (this_lower * other_lower > this_upper * other_upper) ? (this_lower * other_lower) : (this_upper * other_upper);
-					break;
-				case (char)0x42:
-					// this both other positive
-					//std::cout << *this << '\n' << other << '\n' << "this both other positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_upper * other_upper;
-					break;
-				case (char)0x14:
-					// this positive other negative
-					//std::cout << *this << '\n' << other << '\n' << "this positive other negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_lower * other_upper;
-					break;
-				case (char)0x24:
-					// this positive other both
-					//std::cout << *this << '\n' << other << '\n' << "this positive other both" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_upper * other_upper;
-					break;
-				case (char)0x44:
-					// this positive other positive
-					//std::cout << *this << '\n' << other << '\n' << "both positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_lower;
-					set_round_up();
-					upper_ = this_upper * other_upper;
-					break;
-				default:
-					//std::cout << *this << '\n' << other << '\n' << "this or other zero" << "\n\n";
-					lower_ = zero();
-					upper_ = zero();
+				// Record arithmetic operation
+				record_arithmetic_op();
+				return *this;
 			}
-			
-			// Record arithmetic operation
-			record_arithmetic_op();
 
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
-			return *this;
-		}
+			// Hold users rounding mode for the duration of the operation
+			[[maybe_unused]] typename Rounding::guard rounding_guard;
 
-		interval& operator +=( const interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
-
-			// Legacy code from non-const version
+			// Capture values to prevent aliasing
 			real_type this_lower = lower();
 			real_type this_upper = upper();
 			real_type other_lower = other.lower();
 			real_type other_upper = other.upper();
 
 			// Perform calculations with appropriate rounding modes
-			set_round_down();
-			lower_ = this_lower + other_lower;
-			set_round_up();
-			upper_ = this_upper + other_upper;
+			lower_ = Rounding::add_down(this_lower, other_lower);
+			upper_ = Rounding::add_up(this_upper, other_upper);
 
 			// Record arithmetic operation
 			record_arithmetic_op();
-
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
 			return *this;
 		}
 
 		interval& operator -=( const interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
+			if constexpr( negated_lower ) {
+				// Hold users rounding mode; round upward throughout
+				[[maybe_unused]] typename Rounding::upward_guard rounding_guard;
 
-			// Legacy code from non-const version
+				// Capture values to prevent aliasing
+				real_type this_neg_lower = lower_;
+				real_type other_neg_lower = other.lower_;
+
+				// -(a - b) == (-a) + b, so both bounds are sums
+				lower_ = add_rounded(this_neg_lower, other.upper_);
+				upper_ = add_rounded(upper_, other_neg_lower);
+
+				// Record arithmetic operation
+				record_arithmetic_op();
+				return *this;
+			}
+
+			// Hold users rounding mode for the duration of the operation
+			[[maybe_unused]] typename Rounding::guard rounding_guard;
+
+			// Capture values to prevent aliasing
 			real_type this_lower = lower();
 			real_type this_upper = upper();
 			real_type other_lower = other.lower();
 			real_type other_upper = other.upper();
 
 			// Perform calculations with appropriate rounding modes
-			set_round_down();
-			lower_ = this_lower - other_upper;
-			set_round_up();
-			upper_ = this_upper - other_lower;
+			lower_ = Rounding::sub_down(this_lower, other_upper);
+			upper_ = Rounding::sub_up(this_upper, other_lower);
 
 			// Record arithmetic operation
 			record_arithmetic_op();
-
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
 			return *this;
 		}
 
 		interval& operator *=( const interval& other ) {
-			// Store users current rounding mode
-			int user_rounding_mode = std::fegetround();
+			if constexpr( RA_INTERVAL_BRANCHLESS_MUL && !products_set_rounding_mode ) {
+				return multiply_branchless( other );
+			} else {
+				return multiply_by_lookup( other );
+			}
+		}
 
-			// Legacy code from non-const version
+		// Multiplication by classifying the signs of both operands and
+		// computing only the two products that can be extremal.
+		interval& multiply_by_lookup( const interval& other ) {
+			// Hold users rounding mode for the duration of the operation
+			[[maybe_unused]] guard_type rounding_guard;
+
+			// Capture values to prevent aliasing
 			real_type this_lower = lower();
 			real_type this_upper = upper();
 			real_type other_lower = other.lower();
@@ -244,115 +226,138 @@ class interval {
 				case (char)0x11:
 					// both negative
 					//std::cout << *this << '\n' << other << '\n' << "both negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_upper;
-					set_round_up();
-					upper_ = this_lower * other_lower;
+					lower_ = product_lower(this_upper, other_upper);
+					upper_ = product_upper(this_lower, other_lower);
 					break;
 				case (char)0x21:
 					// this negative other both
 					//std::cout << *this << '\n' << other << '\n' << "this negative other both" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_lower * other_lower;
+					lower_ = product_lower(this_lower, other_upper);
+					upper_ = product_upper(this_lower, other_lower);
 					break;
 				case (char)0x41:
 					// this negative other positive
 					//std::cout << *this << '\n' << other << '\n' << "this negative other positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_upper * other_lower;
+					lower_ = product_lower(this_lower, other_upper);
+					upper_ = product_upper(this_upper, other_lower);
 					break;
 				case (char)0x12:
 					// this both other negative
 					//std::cout << *this << '\n' << other << '\n' << "this both other negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_lower * other_lower;
+					lower_ = product_lower(this_upper, other_lower);
+					upper_ = product_upper(this_lower, other_lower);
 					break;
 				case (char)0x22:
 					// both both
 					//std::cout << *this << '\n' << other << '\n' << "both both" << "\n\n";
-					set_round_down();
-					lower_ = (this_lower * other_upper < this_upper * other_lower) ? (this_lower * other_upper) : (this_upper * other_lower);
-					set_round_up();
-					upper_ = (this_lower * other_lower > this_upper * other_upper) ? (this_lower * other_lower) : (this_upper * other_upper);
+					{
+						real_type lower_a = product_lower(this_lower, other_upper);
+						real_type lower_b = product_lower(this_upper, other_lower);
+						real_type upper_a = product_upper(this_lower, other_lower);
+						real_type upper_b = product_upper(this_upper, other_upper);
+						lower_ = lesser_lower(lower_a, lower_b);
+						upper_ = (upper_a > upper_b) ? upper_a : upper_b;
+					}
 					break;
 				case (char)0x42:
 					// this both other positive
 					//std::cout << *this << '\n' << other << '\n' << "this both other positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_upper;
-					set_round_up();
-					upper_ = this_upper * other_upper;
+					lower_ = product_lower(this_lower, other_upper);
+					upper_ = product_upper(this_upper, other_upper);
 					break;
 				case (char)0x14:
 					// this positive other negative
 					//std::cout << *this << '\n' << other << '\n' << "this positive other negative" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_lower * other_upper;
+					lower_ = product_lower(this_upper, other_lower);
+					upper_ = product_upper(this_lower, other_upper);
 					break;
 				case (char)0x24:
 					// this positive other both
 					//std::cout << *this << '\n' << other << '\n' << "this positive other both" << "\n\n";
-					set_round_down();
-					lower_ = this_upper * other_lower;
-					set_round_up();
-					upper_ = this_upper * other_upper;
+					lower_ = product_lower(this_upper, other_lower);
+					upper_ = product_upper(this_upper, other_upper);
 					break;
 				case (char)0x44:
 					// this positive other positive
 					//std::cout << *this << '\n' << other << '\n' << "both positive" << "\n\n";
-					set_round_down();
-					lower_ = this_lower * other_lower;
-					set_round_up();
-					upper_ = this_upper * other_upper;
+					lower_ = product_lower(this_lower, other_lower);
+					upper_ = product_upper(this_upper, other_upper);
 					break;
 				default:
 					//std::cout << *this << '\n' << other << '\n' << "this or other zero" << "\n\n";
-					lower_ = zero();
+					lower_ = stored_lower(zero());
 					upper_ = zero();
 			}
 			
 			// Record arithmetic operation
 			record_arithmetic_op();
+			return *this;
+		}
+
+		// Multiplication by taking the least and greatest of all four
+		// endpoint products. There are no branches on the signs of the
+		// operands; the min/max selections compile to min/max instructions.
+		// Unlike multiply_by_lookup, a zero operand may produce a zero bound
+		// with a negative sign.
+		interval& multiply_branchless( const interval& other ) {
+			// Hold users rounding mode for the duration of the operation
+			[[maybe_unused]] guard_type rounding_guard;
+
+			// Capture values to prevent aliasing
+			real_type this_lower = lower();
+			real_type this_upper = upper();
+			real_type other_lower = other.lower();
+			real_type other_upper = other.upper();
+
+			lower_ = lesser_lower(
+			  lesser_lower(product_lower(this_lower, other_lower), product_lower(this_lower, other_upper)),
+			  lesser_lower(product_lower(this_upper, other_lower), product_lower(this_upper, other_upper)) );
+			upper_ = greater_upper(
+			  greater_upper(product_upper(this_lower, other_lower), product_upper(this_lower, other_upper)),
+			  greater_upper(product_upper(this_upper, other_lower), product_upper(this_upper, other_upper)) );
 
-			// Restore users rounding mode
-			assert( !std::fesetround(user_rounding_mode) );
+			// Record arithmetic operation
+			record_arithmetic_op();
 			return *this;
 		}
 
-		real_type lower() const { return lower_; }
+		real_type lower() const { return stored_lower(lower_); }
 
 		real_type upper() const { return upper_; }
 
 		bool is_singleton() const { return upper() == lower(); }
 
+		// Throws indeterminate_result if the sign cannot be determined.
 		int sign() const {
+			certain_sign result = sign_or_uncertain();
+			if( result == certain_sign::uncertain ) {
+				throw indeterminate_result {"Cannot determine sign of interval"};
+			}
+			return static_cast<int>(result);
+		}
+
+		// Like sign, but reports an indeterminate sign as uncertain instead
+		// of throwing.
+		certain_sign sign_or_uncertain() const {
 			if( upper() < 0 ) {
-				return -1;
+				return certain_sign::negative;
 			}else if( lower() > 0 ) {
-				return 1;
+				return certain_sign::positive;
 			}else if( (lower() == 0) && (upper() == 0) ) {
-				return 0;
+				return certain_sign::zero;
 			}else {
-				// Record indeterminate result and throw exception
+				// Record indeterminate result
 				record_indeterminate_result();
-				throw indeterminate_result {"Cannot determine sign of interval"};
+				return certain_sign::uncertain;
 			}
 		}
 
-		static void clear_statistics() {
-			statistics_.indeterminate_result_count = 0;
-			statistics_.arithmetic_op_count = 0;
-		}
-
-		static void get_statistics( statistics& stat ) { stat = statistics_; }
+		// Queries on the sign of every value in the interval. These never
+		// throw and are not counted as indeterminate results.
+		bool certainly_negative() const { return upper() < 0; }
+		bool certainly_positive() const { return lower() > 0; }
+		bool certainly_zero() const { return (lower() == 0) && (upper() == 0); }
+		bool possibly_zero() const { return (lower() <= 0) && (upper() >= 0); }
 
 		bool operator == ( const interval& other ) const { return (upper() == other.upper()) && (lower() == other.lower()); }
 
@@ -389,180 +394,110 @@ class interval {
 		
 		static real_type zero() { return real_type(0); }
 		
-		static void set_round_down() { assert( !std::fesetround(FE_DOWNWARD) ); }
-		
-		static void set_round_up() { assert( !std::fesetround(FE_UPWARD) ); }
+		static void set_round_down() { set_rounding_mode(FE_DOWNWARD); }
 		
-		static void record_indeterminate_result() { ++(statistics_.indeterminate_result_count); }
-		static void record_arithmetic_op() { ++(statistics_.arithmetic_op_count); }
+		static void set_round_up() { set_rounding_mode(FE_UPWARD); }
 
 	private:
-		real_type lower_;
-		real_type upper_;
-		static inline statistics statistics_ {0,0};
-};
-
-template<typename T>
-interval<T> operator + ( const interval<T>& A, const interval<T>& B ) {
-	// Store users current rounding mode
-	int user_rounding_mode = std::fegetround();
+		static constexpr bool negated_lower = std::is_same_v<Storage, negated_lower_storage>;
 
-	// Declare variables to store result
-	T result_lower;
-	T result_upper;
+		// Whether product_lower and product_upper each set the rounding mode.
+		static constexpr bool products_set_rounding_mode =
+		  Rounding::sets_rounding_mode && !negated_lower;
 
-	// Perform calculations with appropriate rounding modes
-	interval<T>::set_round_down();
-	result_lower = A.lower() + B.lower();
-	interval<T>::set_round_up();
-	result_upper = A.upper() + B.upper();
+		// The guard held by operations built on the bound helpers below.
+		using guard_type = std::conditional_t<negated_lower,
+		  typename Rounding::upward_guard, typename Rounding::guard>;
 
-	// Record arithmetic operation
-	interval<T>::record_arithmetic_op();
-
-	// Restore users rounding mode
-	assert( !std::fesetround(user_rounding_mode) );
-	
-	return interval<T>( result_lower, result_upper );
-}
+		// Convert between a lower bound and its stored representation
+		// (the conversion is its own inverse).
+		static real_type stored_lower( real_type x ) {
+			if constexpr( negated_lower ) { return -x; } else { return x; }
+		}
 
-template<typename T>
-interval<T> operator - ( const interval<T>& A, const interval<T>& B ) {
-	// Store users current rounding mode
-	int user_rounding_mode = std::fegetround();
+		// Stored lower and upper bounds of the product a * b.
+		static real_type product_lower( real_type a, real_type b ) {
+			if constexpr( negated_lower ) {
+				return mul_rounded(-a, b);
+			} else {
+				return Rounding::mul_down(a, b);
+			}
+		}
+		static real_type product_upper( real_type a, real_type b ) {
+			if constexpr( negated_lower ) {
+				return mul_rounded(a, b);
+			} else {
+				return Rounding::mul_up(a, b);
+			}
+		}
 
-	// Declare variables to hold return value
-	T result_lower;
-	T result_upper;
+		// The stored representation of the lesser of two lower bounds
+		// given in stored representation.
+		static real_type lesser_lower( real_type a, real_type b ) {
+			if constexpr( negated_lower ) {
+				return (a > b) ? a : b;
+			} else {
+				return (a < b) ? a : b;
+			}
+		}
 
-	// Perform calculations with appropriate rounding modes
-	interval<T>::set_round_down();
-	result_lower = A.lower() - B.upper();
-	interval<T>::set_round_up();
-	result_upper = A.upper() - B.lower();
+		// The greater of two upper bounds.
+		static real_type greater_upper( real_type a, real_type b ) { return (a > b) ? a : b; }
 
-	// Record arithmetic operation
-	interval<T>::record_arithmetic_op();
+		// The lower bound (negated under negated_lower_storage).
+		real_type lower_;
+		real_type upper_;
+};
 
-	// Restore users rounding mode
-	assert( !std::fesetround(user_rounding_mode) );
-	
-	return interval<T>( result_lower, result_upper );
+template<typename T, class Rounding, class Storage>
+interval<T, Rounding, Storage> operator + ( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	interval<T, Rounding, Storage> result(A);
+	result += B;
+	return result;
 }
 
-template<typename T>
-interval<T> operator * ( const interval<T>& A, const interval<T>& B ) {
-	// Store users current rounding mode
-	int user_rounding_mode = std::fegetround();
-
-	// Declare variables to hold return value
-	T result_lower;
-	T result_upper;
-
-	// Create 8-bit lookup table for upcoming switch
-	char lookup = A.get_mul_lookup_table_for( B );
-
-	// Perform calculations with appropriate rounding modes
-	switch( lookup ) {
-		case (char)0x11:
-			// both negative
-			//std::cout << *this << '\n' << other << '\n' << "both negative" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.upper() * B.upper();
-			interval<T>::set_round_up();
-			result_upper = A.lower() * B.lower();
-			break;
-		case (char)0x21:
-			// this negative other both
-			//std::cout << *this << '\n' << other << '\n' << "this negative other both" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.lower() * B.upper();
-			interval<T>::set_round_up();
-			result_upper = A.lower() * B.lower();
-			break;
-		case (char)0x41:
-			// this negative other positive
-			//std::cout << *this << '\n' << other << '\n' << "this negative other positive" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.lower() * B.upper();
-			interval<T>::set_round_up();
-			result_upper = A.upper() * B.lower();
-			break;
-		case (char)0x12:
-			// this both other negative
-			//std::cout << *this << '\n' << other << '\n' << "this both other negative" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.upper() * B.lower();
-			interval<T>::set_round_up();
-			result_upper = A.lower() * B.lower();
-			break;
-		case (char)0x22:
-			// both both
-			//std::cout << *this << '\n' << other << '\n' << "both both" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = (A.lower() * B.upper() < A.upper() * B.lower()) ? (A.lower() * B.upper()) : (A.upper() * B.lower());
-			interval<T>::set_round_up();
-			result_upper = (A.lower() * B.lower() > A.upper() * B.upper()) ? (A.lower() * B.lower()) : (A.upper() * B.upper());
-			break;
-		case (char)0x42:
-			// this both other positive
-			//std::cout << *this << '\n' << other << '\n' << "this both other positive" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.lower() * B.upper();
-			interval<T>::set_round_up();
-			result_upper = A.upper() * B.upper();
-			break;
-		case (char)0x14:
-			// this positive other negative
-			//std::cout << *this << '\n' << other << '\n' << "this positive other negative" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.upper() * B.lower();
-			interval<T>::set_round_up();
-			result_upper = A.lower() * B.upper();
-			break;
-		case (char)0x24:
-			// this positive other both
-			//std::cout << *this << '\n' << other << '\n' << "this positive other both" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.upper() * B.lower();
-			interval<T>::set_round_up();
-			result_upper = A.upper() * B.upper();
-			break;
-		case (char)0x44:
-			// this positive other positive
-			//std::cout << *this << '\n' << other << '\n' << "both positive" << "\n\n";
-			interval<T>::set_round_down();
-			result_lower = A.lower() * B.lower();
-			interval<T>::set_round_up();
-			result_upper = A.upper() * B.upper();
-			break;
-		default:
-			//std::cout << *this << '\n' << other << '\n' << "this or other zero" << "\n\n";
-			result_lower = interval<T>::zero();
-			result_upper = interval<T>::zero();
-	}
-			
-	// Record arithmetic operation
-	interval<T>::record_arithmetic_op();
+template<typename T, class Rounding, class Storage>
+interval<T, Rounding, Storage> operator - ( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	interval<T, Rounding, Storage> result(A);
+	result -= B;
+	return result;
+}
 
-	// Restore users rounding mode
-	assert( !std::fesetround(user_rounding_mode) );
-	
-	return interval<T>( result_lower, result_upper );
+template<typename T, class Rounding, class Storage>
+interval<T, Rounding, Storage> operator * ( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	interval<T, Rounding, Storage> result(A);
+	result *= B;
+	return result;
 }
 
-template<typename T>
-bool operator < ( const interval<T>& A, const interval<T>& B ) {
-	if( (A.upper() < B.lower()) || (A.lower() >= B.upper()) ) {
-		return A.upper() < B.lower();
+// Throws indeterminate_result if the result cannot be determined, i.e.,
+// if neither certainly_less nor certainly_not_less holds.
+template<typename T, class Rounding, class Storage>
+bool operator < ( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	if( certainly_less(A, B) ) {
+		return true;
+	}else if( certainly_not_less(A, B) ) {
+		return false;
 	}else {
-		interval<T>::record_indeterminate_result();
+		interval<T, Rounding, Storage>::record_indeterminate_result();
 		throw indeterminate_result {"Cannot determine result of less-than comparison"};
 	}
 }
 
-template<typename T>
-std::ostream& operator << ( std::ostream& out, const interval<T>& insertee ) {
+// Every value in A is less than every value in B.
+template<typename T, class Rounding, class Storage>
+bool certainly_less( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	return A.upper() < B.lower();
+}
+
+// No value in A is less than any value in B.
+template<typename T, class Rounding, class Storage>
+bool certainly_not_less( const interval<T, Rounding, Storage>& A, const interval<T, Rounding, Storage>& B ) {
+	return A.lower() >= B.upper();
+}
+
+template<typename T, class Rounding, class Storage>
+std::ostream& operator << ( std::ostream& out, const interval<T, Rounding, Storage>& insertee ) {
 	out << '[';
 	out << insertee.lower();
 	out << ',';
@@ -571,3 +506,5 @@ std::ostream& operator << ( std::ostream& out, const interval<T>& insertee ) {
 	return out;
 }
 }
+
+#endif
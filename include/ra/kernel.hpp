@@ -1,22 +1,181 @@
+#include "ra/bigfloat.hpp"
+#include "ra/exact_predicates.hpp"
+#include "ra/filters.hpp"
 #include "ra/interval.hpp"
+#include "ra/packed_interval.hpp"
+#include "ra/predicate_cache.hpp"
+#include "ra/statistics.hpp"
 #include <CGAL/Cartesian.h>
 #include <CGAL/MP_Float.h>
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace ra::geometry {
 
+// The interval type used by default to filter predicates over R.
 template<class R>
+struct default_interval {
+	using type = ra::math::interval<R, ra::math::protected_rounding<R>>;
+};
+
+#if defined(__SSE2__)
+// Both bounds of an interval over double fit in one SSE2 register.
+template<>
+struct default_interval<double> {
+	using type = ra::math::interval<double, ra::math::protected_rounding<double>,
+	  ra::math::packed_storage>;
+};
+#endif
+
+// The exact policy used by default to decide predicates over R that the
+// filters leave uncertain (see ra/exact_predicates.hpp).
+template<class R>
+struct default_exact {
+	using type = number_type_exact<CGAL::MP_Float>;
+};
+
+// Coordinates of type float and double are handled with floating-point
+// expansions, and inputs out of their range with a 1152-bit bigfloat;
+// neither allocates. MP_Float is only used for inputs whose magnitudes
+// are so far apart that a determinant does not fit in the bigfloat (for
+// side_of_oriented_circle, more than about 2^230 apart), or for all
+// inputs out of the range of expansions where there is no bigfloat.
+template<>
+struct default_exact<double> {
+#if defined(__SIZEOF_INT128__)
+	using type = expansion_exact<bounded_number_type_exact<ra::math::bigfloat<18>,
+	  number_type_exact<CGAL::MP_Float>>>;
+#else
+	using type = expansion_exact<number_type_exact<CGAL::MP_Float>>;
+#endif
+};
+
+template<>
+struct default_exact<float> {
+	using type = default_exact<double>::type;
+};
+
+#if defined(__SIZEOF_INT128__)
+// Integer coordinates of at most 32 bits, such as those snapped to a
+// fixed-point grid, are handled in 128-bit integer arithmetic (see
+// integer_exact), and the preferred-direction test with expansions.
+template<>
+struct default_exact<std::int32_t> {
+	using type = integer_exact<default_exact<double>::type>;
+};
+#endif
+
+// The filter chain used by default for predicates over R (see
+// ra/filters.hpp): the static filter (if R is an IEEE 754 type), then the
+// interval filter, then the exact stage.
+template<class R, bool = std::numeric_limits<R>::is_iec559>
+struct default_filters {
+	using type = std::tuple<static_filter<R>,
+	  interval_filter<typename default_interval<R>::type>,
+	  exact_filter<typename default_exact<R>::type>>;
+};
+
+template<class R>
+struct default_filters<R, false> {
+	using type = std::tuple<interval_filter<typename default_interval<R>::type>,
+	  exact_filter<typename default_exact<R>::type>>;
+};
+
+// Coordinates of type double also go through double-double arithmetic
+// before the exact stage.
+template<>
+struct default_filters<double> {
+	using type = std::tuple<static_filter<double>,
+	  interval_filter<default_interval<double>::type>, double_double_filter,
+	  exact_filter<default_exact<double>::type>>;
+};
+
+// Coordinates of type float are promoted to double throughout: the first
+// stage decides every orientation test exactly (see float_filter), and
+// the interval stage over double proves the sign of many degenerate
+// side-of-oriented-circle tests, whose evaluation is then exact, without
+// reaching the exact stage.
+template<>
+struct default_filters<float> {
+	using type = std::tuple<float_filter,
+	  interval_filter<default_interval<double>::type>, double_double_filter,
+	  exact_filter<default_exact<float>::type>>;
+};
+
+// The integer evaluation of orientation and side-of-oriented-circle tests
+// costs about as much as a static filter, so integer coordinates go
+// straight to the exact stage. (Without 128-bit integers, that stage is
+// MP_Float, and an interval filter over the coordinate type would
+// overflow.)
+template<>
+struct default_filters<std::int32_t> {
+	using type = std::tuple<exact_filter<default_exact<std::int32_t>::type>>;
+};
+
+// The number, point and vector types of a kernel whose first template
+// parameter is R: if R is a number type, the points and vectors of
+// CGAL::Cartesian<R>; if R is a CGAL representation class (one with a
+// nested FT), such as CGAL::Simple_cartesian<double>, its own. The points
+// of CGAL::Cartesian are reference-counted handles to a separately
+// allocated representation; those of CGAL::Simple_cartesian hold their
+// coordinates directly, so reading a point costs no indirection and
+// copying one touches no reference count.
+template<class R, class = void>
+struct kernel_representation {
+	using Real = R;
+	using Point = typename CGAL::Cartesian<R>::Point_2;
+	using Vector = typename CGAL::Cartesian<R>::Vector_2;
+};
+
+template<class R>
+struct kernel_representation<R, std::void_t<typename R::FT>> {
+	using Real = typename R::FT;
+	using Point = typename R::Point_2;
+	using Vector = typename R::Vector_2;
+};
+
+// Whether H is a vertex handle whose vertex provides id() (see
+// Kernel::Vertex_id_of).
+template<class H, class = void>
+struct has_vertex_id : std::false_type {};
+
+template<class H>
+struct has_vertex_id<H, std::enable_if_t<std::is_convertible_v<decltype(
+  std::declval<const H&>()->id()), std::size_t>>> : std::true_type {};
+
+// Template parameters:
+// R        The type used to represent real numbers, or a CGAL
+//          representation class over that type whose points and vectors
+//          the kernel is to use (see kernel_representation); for example,
+//          Kernel<CGAL::Simple_cartesian<double>> is Kernel<double> with
+//          points that are not reference-counted.
+// Filters  The stages through which each predicate is decided, in order
+//          (see ra/filters.hpp); the first stage that is not uncertain
+//          gives the result, so the last stage must be exact. If none are
+//          given, the chain is default_filters<Real>::type. For example,
+//            Kernel<double, interval_filter<I>, exact_filter<E>>
+//          skips the static and double-double filters, and
+//            Kernel<double, exact_filter<E>>
+//          decides everything exactly. The chain is fixed at compile
+//          time; nothing is dispatched at run time.
+template<class R, class... Filters>
 class Kernel {
 	public:
 
 	// The type used to represent real numbers.
-	using Real = R;
+	using Real = typename kernel_representation<R>::Real;
 
 	// The type used to represent points in two dimensions.
-	using Point = typename CGAL::Cartesian<R>::Point_2;
+	using Point = typename kernel_representation<R>::Point;
 
 	// The type used to represent vectors in two dimensions.
-	using Vector = typename CGAL::Cartesian<R>::Vector_2;
+	using Vector = typename kernel_representation<R>::Vector;
 
 	// Bug fix needed for triangulation_2.hpp to work
 	using Point_2 = Point;
@@ -35,6 +194,18 @@ class Kernel {
 		on_positive_side = 1,
 	};
 
+	// The outcome of a quadrilateral classification (see classify_quad).
+	struct Quad_classification {
+		// Whether the quadrilateral is strictly convex. This is only
+		// decided if the diagonal is not locally Delaunay (the only case
+		// in which an edge flip needs it), and is false otherwise.
+		bool strictly_convex;
+
+		// Whether its diagonal is locally Delaunay with respect to the
+		// preferred directions.
+		bool locally_pd_delaunay;
+	};
+
 	// The set of statistics maintained by the kernel.
 	struct Statistics {
 		// The total number of orientation tests.
@@ -56,100 +227,220 @@ class Kernel {
 		// The number of side-of-oriented-circle tests requiring exact
 		// arithmetic.
 		std::size_t side_of_oriented_circle_exact_count;
+
+		// The number of orientation tests not decided by the static
+		// filter, and so requiring interval arithmetic.
+		std::size_t orientation_interval_count;
+
+		// The number of side-of-oriented-circle tests not decided by the
+		// static filter, and so requiring interval arithmetic.
+		std::size_t side_of_oriented_circle_interval_count;
+
+		// The number of orientation tests not decided by interval
+		// arithmetic, and so requiring double-double arithmetic.
+		std::size_t orientation_double_double_count;
+
+		// The number of preferred-direction tests not decided by interval
+		// arithmetic, and so requiring double-double arithmetic.
+		std::size_t preferred_direction_double_double_count;
+
+		// The number of side-of-oriented-circle tests not decided by
+		// interval arithmetic, and so requiring double-double arithmetic.
+		std::size_t side_of_oriented_circle_double_double_count;
+
+		// The number of quadrilateral classifications found in the
+		// predicate cache (see enable_predicate_cache); their tests are
+		// not counted above.
+		std::size_t predicate_cache_hit_count;
+
+		// The number of quadrilateral classifications looked up in the
+		// predicate cache but not found there, and so evaluated.
+		std::size_t predicate_cache_miss_count;
+
+		// The number of preferred-direction tests not decided by the
+		// static filter, and so requiring interval arithmetic.
+		std::size_t preferred_direction_interval_count;
 	};
 
-	// Since a kernel object is stateless, construction and destruction are
-	// trivial.
+	// The type of the filter chain.
+	using Filter_chain = std::conditional_t<sizeof...(Filters) == 0,
+	  typename default_filters<Real>::type, std::tuple<Filters...>>;
+
+	// The number of stages in the filter chain.
+	static constexpr std::size_t num_stages = std::tuple_size_v<Filter_chain>;
+
+	// The statistics of one stage of the filter chain: the number of tests
+	// of each kind that reached it (that is, were not decided by an
+	// earlier stage). The counts of the first stage are the totals.
+	// Statistics reports the same counts by the kind of the stage.
+	struct Stage_statistics {
+		// The name of the stage.
+		const char* name;
+
+		std::size_t orientation_count;
+		std::size_t preferred_direction_count;
+		std::size_t side_of_oriented_circle_count;
+	};
+
+	using Chain_statistics = std::array<Stage_statistics, num_stages>;
+
+	// What a vertex keeps for the predicate cache (see point_cache and
+	// enable_predicate_cache). The vertices of trilib::Triangulation_2
+	// keep one each.
+	using Point_cache = point_cache;
+
+	// Valid (as void) if H is a vertex handle whose vertex provides
+	// point() and point_cache(), the latter returning a modifiable
+	// Point_cache for its point.
+	template<class H>
+	using Point_cache_of = std::enable_if_t<std::is_same_v<decltype(
+	  std::declval<const H&>()->point_cache()), Point_cache&>>;
+
+	// Valid (as void) if H is a vertex handle whose vertex provides id(),
+	// an integer that is distinct for distinct vertices and fixed for the
+	// lifetime of the vertex (see side_of_oriented_circle_perturbed).
+	template<class H>
+	using Vertex_id_of = std::enable_if_t<has_vertex_id<H>::value>;
+
+	// A kernel object holds its filter stages, whose state is at most the
+	// bounds used by semi-static filters (see configure_for_bbox), and its
+	// predicate cache; a default-constructed kernel has no bounds
+	// configured and the cache disabled.
 	Kernel() = default;
 	~Kernel() = default;
 
-	// The kernel type is both movable and copyable; but since it is stateless,
-	// both the move and copy operations are trivial.
+	// The kernel type is both movable and copyable; copies share the
+	// configuration of the original, and start with a copy of its
+	// predicate cache.
 	Kernel(const Kernel&) = default;
 	Kernel& operator=(const Kernel&) = default;
 	Kernel(Kernel&&) = default;
 	Kernel& operator=(Kernel&&) = default;
 
-	Orientation orientation( const Point& a, const Point& b, const Point& c ){
+	// Configure the semi-static filters for a bounding box.
+	// Once configured, predicates may only be applied to points whose
+	// coordinates are at most max_abs_coord in magnitude, and (for
+	// preferred_direction) to vectors whose components are at most
+	// max_abs_direction in magnitude. The error bounds of the orientation,
+	// side-of-oriented-circle and preferred-direction determinants are then
+	// computed once here, and most tests are decided by comparing the
+	// determinant, evaluated in plain floating-point arithmetic, against a
+	// fixed bound. Has no effect on a chain without a static filter.
+	void configure_for_bbox( Real max_abs_coord, Real max_abs_direction = Real(1) ){
+		std::apply( [&]( auto&... filters ){
+			( filters.configure_for_bbox(max_abs_coord, max_abs_direction), ... );
+		}, filters_ );
+	}
 
-		// Record orientation
-		did_orientation();
+	// Enable the predicate cache, with 2^log2_size entries, or disable it
+	// if log2_size is zero; the cache starts out empty either way, and is
+	// disabled by default. While it is enabled, classify_quad and
+	// classify_quad_perturbed on vertex handles with ids (see
+	// Vertex_id_of) below 2^32 first look for the outcome of the same
+	// quadrilateral, with the same diagonal and tie-break, in the cache,
+	// and store it there if it is not found. A lookup reads only the ids
+	// and the Point_caches of the vertices, not their points, so a vertex
+	// whose point changes must be passed to invalidate_predicate_cache
+	// before its next lookup. As the key is made of ids, the cache must
+	// be cleared (or reenabled) before it is used on other vertices with
+	// the same ids, such as those of another triangulation. Each entry
+	// takes 24 bytes. Lawson's flip algorithm classifies many
+	// quadrilaterals more than once, but the cache answers only about half
+	// of the lookups in bench_flip, and a hit saves little more than an
+	// incircle test that the static filter decides: make_delaunay is
+	// 0.8-0.93x as fast with it on jittered grids, and 1.03-1.16x on
+	// lattices, where the ties cost more. It is therefore worth enabling
+	// only for inputs with many cocircular points.
+	void enable_predicate_cache( unsigned log2_size ){
+		quad_cache_.resize( log2_size );
+	}
 
-		try{
-			// Compute result as interval
-			Interval result = get_orientation_result<Interval>(a,b,c);
-			return Orientation(result.sign());
-		}
-		catch( ra::math::indeterminate_result& e ){
-
-			// Record exact orientation
-			did_exact_orientation();
-
-			// Compute exact result
-			Exact result = get_orientation_result<Exact>(a,b,c);
-			if( Exact(0) < result ){
-				return Orientation(1);
-			}else if( result < Exact(0) ){
-				return Orientation(-1);
-			}else{
-				return Orientation(0);
-			}
-		}
+	void clear_predicate_cache(){
+		quad_cache_.clear();
 	}
 
-	Oriented_side side_of_oriented_circle( const Point& a, const Point& b, const Point& c, const Point& d ) {
+	// Drop the outcomes cached for the vertex h from every kernel's
+	// predicate cache, as its point has changed.
+	template<class H, class = Point_cache_of<H>>
+	static void invalidate_predicate_cache( const H& h ){
+		h->point_cache().invalidate();
+	}
 
-		// Record side of oriented circle test
-		did_side_of_oriented_circle();
+	Orientation orientation( const Point& a, const Point& b, const Point& c ){
+		return Orientation(decide<0>( orientation_predicate, [&]( const auto& filter ){
+			return filter.orientation(a,b,c);
+		}));
+	}
 
-		try{
-			// Compute result as interval
-			Interval result = get_side_of_oriented_circle_result<Interval>(a,b,c,d);
-			return Oriented_side(result.sign());
-		}
-		catch( ra::math::indeterminate_result& e ) {
-
-			// Record exact side of oriented circle test
-			did_exact_side_of_oriented_circle();
-
-			// Compute exact result
-			Exact result = get_side_of_oriented_circle_result<Exact>(a,b,c,d);
-			if( Exact(0) < result ){
-				return Oriented_side(1);
-			}else if( result < Exact(0) ){
-				return Oriented_side(-1);
-			}else{
-				return Oriented_side(0);
-			}
+	Oriented_side side_of_oriented_circle( const Point& a, const Point& b, const Point& c, const Point& d ) {
+		return Oriented_side(decide<0>( side_of_oriented_circle_predicate,
+		  [&]( const auto& filter ){
+			return filter.side_of_oriented_circle(a,b,c,d);
+		}));
+	}
+
+	// The side-of-oriented-circle test under Simulation of Simplicity: the
+	// lift x^2 + y^2 of the point of each vertex h is taken to be raised
+	// by eps^(1 + h->id()), for an infinitesimal eps > 0. The outcome is
+	// that of side_of_oriented_circle whenever that is not on_boundary,
+	// and is on_boundary only if the four points are collinear. Since the
+	// perturbed points are in general position, the edge flips made on
+	// its outcome (see classify_quad_perturbed) lead to a unique
+	// triangulation, which is a Delaunay triangulation of the unperturbed
+	// points; ties among cocircular points are broken by the vertex ids
+	// alone, at the cost of at most one orientation test.
+	template<class H, class = Vertex_id_of<H>>
+	Oriented_side side_of_oriented_circle_perturbed( const H& a, const H& b, const H& c,
+			const H& d ) {
+		const Point& pa = a->point();
+		const Point& pb = b->point();
+		const Point& pc = c->point();
+		const Point& pd = d->point();
+		Oriented_side side = side_of_oriented_circle(pa,pb,pc,pd);
+		if( side != Oriented_side::on_boundary ){
+			return side;
 		}
+		ra::math::certain_sign orientations[4] = {ra::math::certain_sign::uncertain,
+		  ra::math::certain_sign::uncertain, ra::math::certain_sign::uncertain,
+		  ra::math::certain_sign::uncertain};
+		return Oriented_side(perturbed_side( pa, pb, pc, pd,
+		  perturbation( a, b, c, d ), orientations ));
+	}
+
+	// Batched orientation and side-of-oriented-circle tests, on points
+	// stored as arrays of coordinates: test k takes the points (x[i], y[i])
+	// for the indices i in indices[k], and its outcome goes to result[k].
+	// If the first stage of the filter chain provides batched tests (as
+	// the static filter does, four at a time with AVX2), it evaluates the
+	// tests together; only those it leaves uncertain go through the rest
+	// of the chain, one at a time.
+	template<class Index>
+	void orientation_batch( const Real* x, const Real* y, const Index (*indices)[3],
+			std::size_t n, Orientation* result ) {
+		decide_batch( orientation_predicate, x, y, indices, n, result,
+		  [&]( const auto& filter, std::size_t k, std::size_t m, ra::math::certain_sign* signs ){
+			filter.orientation_batch( x, y, indices + k, m, signs );
+		}, []( const auto& filter, const plain_point<Real> (&p)[3] ){
+			return filter.orientation(p[0],p[1],p[2]);
+		});
+	}
+
+	template<class Index>
+	void side_of_oriented_circle_batch( const Real* x, const Real* y, const Index (*indices)[4],
+			std::size_t n, Oriented_side* result ) {
+		decide_batch( side_of_oriented_circle_predicate, x, y, indices, n, result,
+		  [&]( const auto& filter, std::size_t k, std::size_t m, ra::math::certain_sign* signs ){
+			filter.side_of_oriented_circle_batch( x, y, indices + k, m, signs );
+		}, []( const auto& filter, const plain_point<Real> (&p)[4] ){
+			return filter.side_of_oriented_circle(p[0],p[1],p[2],p[3]);
+		});
 	}
 
 	int preferred_direction( const Point& a, const Point& b,
 			const Point& c, const Point& d, const Vector& v ) {
-		
-		// Record preferred direction test
-		did_preferred_direction();
-
-		try{
-			// Compute result as interval
-			Interval result = get_preferred_direction_result<Interval>(a,b,c,d,v);
-			return(result.sign());
-		}
-		catch( ra::math::indeterminate_result& e ){
-
-			// Record exact preferred direction test
-			did_exact_preferred_direction();
-
-			// Compute exact result
-			Exact result = get_preferred_direction_result<Exact>(a,b,c,d,v);
-			if( Exact(0) < result ){
-				return 1;
-			}else if( result < Exact(0) ){
-				return -1;
-			}else{
-				return 0;
-			}
-		}
+		return decide<0>( preferred_direction_predicate, [&]( const auto& filter ){
+			return filter.preferred_direction(a,b,c,d,v);
+		});
 	}
 
 	bool is_strictly_convex_quad( const Point& a, const Point& b,
@@ -195,147 +486,432 @@ class Kernel {
 		// it is always the case that either e or e' has the
 		// preferred direction locally Delaunay property
 
-		if( static_cast<int>(side_of_oriented_circle(a,b,c,d)) < 0 ) 
+		int side = static_cast<int>(side_of_oriented_circle(a,b,c,d));
+		if( side != 0 )
 		{
-			return true;
+			return side < 0;
 		}
 
-		if( static_cast<int>(side_of_oriented_circle(a,b,c,d)) > 0 )
-		{
-			return false;
-		}
+		return is_preferred_diagonal(c,a,b,d,u,v);
+	}
 
-		if( (preferred_direction(c,a,b,d,u) > 0) ||
-				( (preferred_direction(c,a,b,d,u) == 0) &&
-				  (preferred_direction(c,a,b,d,v) > 0) ) )
-		{
-			return true;
+	// Classify the quadrilateral abcd, with diagonal ac, in a single call:
+	// the result is that of is_locally_pd_delaunay_edge(c,d,a,b,u,v) and,
+	// if that is false, of is_strictly_convex_quad(a,b,c,d), found with
+	// the same tests in the same order. It costs no less than the two
+	// separate calls, which make_delaunay uses; it is the form in which
+	// the predicate cache stores outcomes (see enable_predicate_cache).
+	Quad_classification classify_quad( const Point& a, const Point& b,
+			const Point& c, const Point& d, const Vector& u, const Vector& v ) {
+		return classify_quad_of( a, b, c, d, Preferred_directions {u, v} );
+	}
+
+	template<class H, class = Point_cache_of<H>>
+	Quad_classification classify_quad( const H& a, const H& b, const H& c, const H& d,
+			const Vector& u, const Vector& v ) {
+		if constexpr( has_vertex_id<H>::value ){
+			if( quad_cache_.enabled() ){
+				// The outcomes in the cache are for the preferred
+				// directions of the last call
+				if( (u.x() != cache_u_.x()) || (u.y() != cache_u_.y())
+						|| (v.x() != cache_v_.x()) || (v.y() != cache_v_.y()) ){
+					quad_cache_.clear();
+					cache_u_ = u;
+					cache_v_ = v;
+				}
+				return classify_quad_cached( a, b, c, d, Preferred_directions {u, v} );
+			}
 		}
-		else
-		{
-			return false;
+		return classify_quad_of( a->point(), b->point(), c->point(), d->point(),
+		  Preferred_directions {u, v} );
+	}
+
+	// classify_quad with the ties among cocircular points broken by
+	// side_of_oriented_circle_perturbed instead of by preferred
+	// directions: locally_pd_delaunay is then whether the diagonal ac is
+	// locally Delaunay for the perturbed points, which holds for exactly
+	// one of the two diagonals of a strictly convex quadrilateral. The
+	// orientations found for the convexity test are those that the
+	// perturbation needs, so a cocircular quad costs no further tests.
+	template<class H, class = Point_cache_of<H>, class = Vertex_id_of<H>>
+	Quad_classification classify_quad_perturbed( const H& a, const H& b, const H& c,
+			const H& d ) {
+		if( quad_cache_.enabled() ){
+			return classify_quad_cached( a, b, c, d, perturbation( a, b, c, d ) );
 		}
+		return classify_quad_of( a->point(), b->point(), c->point(), d->point(),
+		  perturbation( a, b, c, d ) );
+	}
 
-		assert(false);
+	// Statistics are counted separately by each thread; get_statistics
+	// reports the totals over all threads and get_thread_statistics the
+	// counts of the calling thread.
+	static void clear_statistics() { Counters::clear(); }
+
+	static void get_statistics( Statistics& statistics ) {
+		typename Counters::counts counts;
+		Counters::merged( counts );
+		statistics = to_statistics( counts );
 	}
 
-	static void clear_statistics() {
-		statistics_.orientation_total_count = 0;
-		statistics_.orientation_exact_count = 0;
-		statistics_.preferred_direction_total_count = 0;
-		statistics_.preferred_direction_exact_count = 0;
-		statistics_.side_of_oriented_circle_total_count = 0;
-		statistics_.side_of_oriented_circle_exact_count = 0;
+	static void get_thread_statistics( Statistics& statistics ) {
+		typename Counters::counts counts;
+		Counters::thread_local_counts( counts );
+		statistics = to_statistics( counts );
 	}
 
-	static void get_statistics( Statistics& statistics ) {
-		statistics.orientation_total_count = statistics_.orientation_total_count;
-		statistics.orientation_exact_count = statistics_.orientation_exact_count;
-		statistics.preferred_direction_total_count = statistics_.preferred_direction_total_count;
-		statistics.preferred_direction_exact_count = statistics_.preferred_direction_exact_count;
-		statistics.side_of_oriented_circle_total_count = statistics_.side_of_oriented_circle_total_count;
-		statistics.side_of_oriented_circle_exact_count = statistics_.side_of_oriented_circle_exact_count;
+	// The same counts, stage by stage.
+	static void get_stage_statistics( Chain_statistics& statistics ) {
+		typename Counters::counts counts;
+		Counters::merged( counts );
+		statistics = to_stage_statistics( counts, std::make_index_sequence<num_stages>() );
+	}
+
+	static void get_thread_stage_statistics( Chain_statistics& statistics ) {
+		typename Counters::counts counts;
+		Counters::thread_local_counts( counts );
+		statistics = to_stage_statistics( counts, std::make_index_sequence<num_stages>() );
 	}
 
 	static void printstat() {
+		Statistics statistics;
+		get_statistics( statistics );
 		std::cout << '\n';
-		std::cout << "Orientation total count:\t\t" << statistics_.orientation_total_count << '\n';
-		std::cout << "Orientation exact count:\t\t" << statistics_.orientation_exact_count << '\n';
-		std::cout << "Preferred direction total count:\t" << statistics_.preferred_direction_total_count << '\n';
-		std::cout << "Preferred direction exact count:\t" << statistics_.preferred_direction_exact_count << '\n';
-		std::cout << "Side of oriented circle total count:\t" << statistics_.side_of_oriented_circle_total_count << '\n';
-		std::cout << "Side of oriented circle exact count:\t" << statistics_.side_of_oriented_circle_exact_count << '\n';
+		std::cout << "Orientation total count:\t\t" << statistics.orientation_total_count << '\n';
+		std::cout << "Orientation interval count:\t\t" << statistics.orientation_interval_count << '\n';
+		std::cout << "Orientation double-double count:\t" << statistics.orientation_double_double_count << '\n';
+		std::cout << "Orientation exact count:\t\t" << statistics.orientation_exact_count << '\n';
+		std::cout << "Preferred direction total count:\t" << statistics.preferred_direction_total_count << '\n';
+		std::cout << "Preferred direction interval count:\t" << statistics.preferred_direction_interval_count << '\n';
+		std::cout << "Preferred direction double-double count:\t" << statistics.preferred_direction_double_double_count << '\n';
+		std::cout << "Preferred direction exact count:\t" << statistics.preferred_direction_exact_count << '\n';
+		std::cout << "Side of oriented circle total count:\t" << statistics.side_of_oriented_circle_total_count << '\n';
+		std::cout << "Side of oriented circle interval count:\t" << statistics.side_of_oriented_circle_interval_count << '\n';
+		std::cout << "Side of oriented circle double-double count:\t" << statistics.side_of_oriented_circle_double_double_count << '\n';
+		std::cout << "Side of oriented circle exact count:\t" << statistics.side_of_oriented_circle_exact_count << '\n';
+		std::cout << "Predicate cache hit count:\t\t" << statistics.predicate_cache_hit_count << '\n';
+		std::cout << "Predicate cache miss count:\t\t" << statistics.predicate_cache_miss_count << '\n';
 		std::cout << '\n';
 	}
 
 	private:
-	
-	static inline Statistics statistics_ {0,0,0,0,0,0};
-
-	// The type used to perform interval arithmetic.
-	using Interval = ra::math::interval<R>;
-
-	// The type used to perform exact arithmetic.
-	using Exact = CGAL::MP_Float;
-
-	template<class T>
-	T get_orientation_result( const Point& a, const Point& b, const Point& c ) const {
-		T ax(a.x());
-		T ay(a.y());
-		T bx(b.x());
-		T by(b.y());
-		T cx(c.x());
-		T cy(c.y());
-		
-		// Calculate and return determinant
-		return ( ((ax - cx) * (by - cy)) - ((ay - cy) * (bx - cx)) );
-	}
-
-	template<class T>
-	T get_side_of_oriented_circle_result( const Point& a, const Point& b, const Point& c,
-			const Point& d ) const {
-		T ax(a.x());
-		T ay(a.y());
-		T az = (ax * ax) + (ay * ay);
-
-		T bx(b.x());
-		T by(b.y());
-		T bz = (bx * bx) + (by * by);
-
-		T cx(c.x());
-		T cy(c.y());
-		T cz = (cx * cx) + (cy * cy);
-
-		T dx(d.x());
-		T dy(d.y());
-		T dz = (dx * dx) + (dy * dy);
-
-		// Compute determinant
-		return detfor_orient3d(ax, ay, az, bx, by, bz, cx, cy, cz, dx, dy, dz);
-	}
-		
-	template<class T>
-	T get_preferred_direction_result( const Point& a, const Point& b, const Point& c, 
-			const Point& d, const Vector& v ) const {
-		T ax(a.x());
-		T ay(a.y());
-
-		T bx(b.x());
-		T by(b.y());
-
-		T cx(c.x());
-		T cy(c.y());
-
-		T dx(d.x());
-		T dy(d.y());
-
-		T vx(v.x());
-		T vy(v.y());
-
-		T atob_mag2 = ((bx - ax) * (bx - ax)) + ((by - ay) * (by - ay));
-		T ctod_mag2 = ((dx - cx) * (dx - cx)) + ((dy - cy) * (dy - cy));
-
-		T atob_dotv = ((bx - ax) * vx) + ((by - ay) * vy);
-		T ctod_dotv = ((dx - cx) * vx) + ((dy - cy) * vy);
-
-		return ( (ctod_mag2 * atob_dotv * atob_dotv)
-			- (atob_mag2 * ctod_dotv * ctod_dotv) );
-	}
-
-	template<class T>
-	T detfor_orient3d ( const T& ax, const T& ay, const T& az, const T& bx, const T& by,
-			const T& bz, const T& cx, const T& cy, const T& cz, const T& dx,
-			const T& dy, const T& dz) const {
-		return ( ((ax - dx) * (((by - dy) * (cz - dz)) - ((bz - dz) * (cy - dy))))
-			- ((bx - dx) * (((ay - dy) * (cz - dz)) - ((az - dz) * (cy - dy))))
-			+ ((cx - dx) * (((ay - dy) * (bz - dz)) - ((az - dz) * (by - dy)))) );
-	}
-
-	static void did_orientation(){ ++(statistics_.orientation_total_count); }
-	static void did_exact_orientation(){ ++(statistics_.orientation_exact_count); }
-	static void did_preferred_direction(){ ++(statistics_.preferred_direction_total_count); }
-	static void did_exact_preferred_direction(){ ++(statistics_.preferred_direction_exact_count); }
-	static void did_side_of_oriented_circle(){ ++(statistics_.side_of_oriented_circle_total_count); }
-	static void did_exact_side_of_oriented_circle(){ ++(statistics_.side_of_oriented_circle_exact_count); }
+
+	// The predicates, each of which has a counter per stage.
+	enum Predicate {
+		orientation_predicate,
+		preferred_direction_predicate,
+		side_of_oriented_circle_predicate,
+		num_predicates
+	};
+
+	// The counters of each predicate and stage, followed by those of the
+	// predicate cache.
+	static constexpr std::size_t cache_hit_counter = num_predicates * num_stages;
+	static constexpr std::size_t cache_miss_counter = cache_hit_counter + 1;
+
+	using Counters = ra::math::counter_registry<Kernel, cache_miss_counter + 1>;
+
+	static_assert( num_stages > 0, "A filter chain needs at least one stage" );
+	static_assert( std::tuple_element_t<num_stages - 1, Filter_chain>::kind == filter_kind::exact,
+	  "The last stage of a filter chain must be exact" );
+
+	Filter_chain filters_;
+
+	quad_cache quad_cache_;
+
+	// The preferred directions for which the outcomes of classify_quad in
+	// quad_cache_ were found.
+	Vector cache_u_ {Real(0), Real(0)};
+	Vector cache_v_ {Real(0), Real(0)};
+
+	// The ways in which classify_quad_of decides whether the diagonal ac of
+	// a cocircular quadrilateral abcd is locally Delaunay (see
+	// break_tie): by the preferred directions u and then v, or by the
+	// perturbation of side_of_oriented_circle_perturbed, given the ids of
+	// a, b, c and d.
+	struct Preferred_directions {
+		const Vector& u;
+		const Vector& v;
+	};
+
+	struct Perturbation {
+		std::size_t ids[4];
+	};
+
+	template<class H>
+	static Perturbation perturbation( const H& a, const H& b, const H& c, const H& d ) {
+		return Perturbation {{static_cast<std::size_t>(a->id()),
+		  static_cast<std::size_t>(b->id()), static_cast<std::size_t>(c->id()),
+		  static_cast<std::size_t>(d->id())}};
+	}
+
+	// classify_quad with ties broken as given by Tie, one of the types
+	// above. The orientations are found only once the diagonal is known
+	// not to be locally Delaunay, and a cocircular quad reuses those its
+	// tie-break needed.
+	template<class P, class Tie>
+	Quad_classification classify_quad_of( const P& a, const P& b, const P& c, const P& d,
+			const Tie& tie ) {
+		using ra::math::certain_sign;
+		certain_sign orientations[4] = {certain_sign::uncertain, certain_sign::uncertain,
+		  certain_sign::uncertain, certain_sign::uncertain};
+		certain_sign side = certain_sign(decide<0>( side_of_oriented_circle_predicate,
+		  [&]( const auto& filter ){
+			return filter.side_of_oriented_circle(a,b,c,d);
+		}));
+		bool pd_delaunay = (side != certain_sign::zero) ? (side == certain_sign::negative)
+		  : break_tie( a, b, c, d, tie, orientations );
+		if( pd_delaunay ){
+			return Quad_classification {false, true};
+		}
+
+		// A quad known not to be convex needs no further orientations
+		bool convex = std::none_of( orientations, orientations + 4, []( certain_sign sign ){
+			return (sign != certain_sign::uncertain) && (sign != certain_sign::positive);
+		});
+		const P* p[] = {&a, &b, &c, &d};
+		for( int i = 0; convex && (i < 4); ++i ){
+			if( orientations[i] == certain_sign::uncertain ){
+				const P& p0 = *p[i];
+				const P& p1 = *p[(i + 1) % 4];
+				const P& p2 = *p[(i + 2) % 4];
+				orientations[i] = certain_sign(decide<0>( orientation_predicate,
+				  [&]( const auto& filter ){
+					return filter.orientation(p0,p1,p2);
+				}));
+			}
+			convex = orientations[i] == certain_sign::positive;
+		}
+		return Quad_classification {convex, false};
+	}
+
+	// classify_quad_of through the predicate cache, which must be enabled.
+	// The outcome is the same for the quadrilateral cdab, with the same
+	// diagonal, so the key starts with whichever of a and c has the
+	// smaller id; it also records the tie-break, so that outcomes with
+	// different ones are not mistaken for each other. The stamp is the
+	// sum of the generations of the vertices, which only grow.
+	template<class H, class Tie>
+	Quad_classification classify_quad_cached( const H& a, const H& b, const H& c,
+			const H& d, const Tie& tie ) {
+		Perturbation ids = perturbation( a, b, c, d );
+		if( (ids.ids[0] | ids.ids[1] | ids.ids[2] | ids.ids[3]) > UINT32_MAX ){
+			return classify_quad_of( a->point(), b->point(), c->point(), d->point(), tie );
+		}
+		std::uint32_t key[4] = {std::uint32_t(ids.ids[0]), std::uint32_t(ids.ids[1]),
+		  std::uint32_t(ids.ids[2]), std::uint32_t(ids.ids[3])};
+		if( key[2] < key[0] ){
+			std::swap( key[0], key[2] );
+			std::swap( key[1], key[3] );
+		}
+		std::uint32_t stamp = a->point_cache().generation() + b->point_cache().generation()
+		  + c->point_cache().generation() + d->point_cache().generation();
+		constexpr unsigned char tie_bit = std::is_same_v<Tie, Perturbation> ? 4 : 0;
+		unsigned char outcome;
+		if( quad_cache_.find( key, stamp, outcome ) && ((outcome & 4) == tie_bit) ){
+#if RA_GEOMETRY_STATS
+			Counters::increment( cache_hit_counter );
+#endif
+			return Quad_classification {(outcome & 1) != 0, (outcome & 2) != 0};
+		}
+#if RA_GEOMETRY_STATS
+		Counters::increment( cache_miss_counter );
+#endif
+		Quad_classification quad = classify_quad_of( a->point(), b->point(), c->point(),
+		  d->point(), tie );
+		quad_cache_.insert( key, stamp, static_cast<unsigned char>(
+		  (quad.strictly_convex ? 1 : 0) | (quad.locally_pd_delaunay ? 2 : 0) | tie_bit) );
+		return quad;
+	}
+
+	// The tie-break of is_locally_pd_delaunay_edge for cocircular points:
+	// whether segment ab is preferred to segment cd with respect to the
+	// directions u and then v.
+	template<class P>
+	bool is_preferred_diagonal( const P& a, const P& b, const P& c, const P& d,
+			const Vector& u, const Vector& v ) {
+		auto preferred = [&]( const Vector& w ){
+			return decide<0>( preferred_direction_predicate, [&]( const auto& filter ){
+				return filter.preferred_direction(a,b,c,d,w);
+			});
+		};
+		int preferred_u = preferred(u);
+		return (preferred_u > 0) || ((preferred_u == 0) && (preferred(v) > 0));
+	}
+
+	// The sign of side_of_oriented_circle_perturbed(a,b,c,d) when the
+	// unperturbed test is zero. The determinant is linear in the lifts,
+	// so its sign is that of the coefficient of the lift of the point with
+	// the smallest id whose coefficient is not zero. That coefficient is
+	// the orientation of the other three points, negated for b and d;
+	// since orientations[i] is that of the points i, i + 1 and i + 2
+	// (modulo 4) of abcd, the coefficient of point k is orientations[k + 1]
+	// up to sign. The orientations that are still uncertain are decided
+	// only if they are needed.
+	template<class P>
+	int perturbed_side( const P& a, const P& b, const P& c, const P& d,
+			const Perturbation& tie, ra::math::certain_sign (&orientations)[4] ) {
+		using ra::math::certain_sign;
+		const P* p[] = {&a, &b, &c, &d};
+		bool done[4] = {false, false, false, false};
+		for( int n = 0; n < 4; ++n ){
+			int k = -1;
+			for( int i = 0; i < 4; ++i ){
+				if( !done[i] && ((k < 0) || (tie.ids[i] < tie.ids[k])) ){
+					k = i;
+				}
+			}
+			done[k] = true;
+			int i = (k + 1) % 4;
+			if( orientations[i] == certain_sign::uncertain ){
+				const P& p0 = *p[i];
+				const P& p1 = *p[(i + 1) % 4];
+				const P& p2 = *p[(i + 2) % 4];
+				orientations[i] = certain_sign(decide<0>( orientation_predicate,
+				  [&]( const auto& filter ){
+					return filter.orientation(p0,p1,p2);
+				}));
+			}
+			if( orientations[i] != certain_sign::zero ){
+				int sign = static_cast<int>(orientations[i]);
+				return (k % 2 == 0) ? sign : -sign;
+			}
+		}
+		return 0;
+	}
+
+	// Whether the diagonal ac of the cocircular quadrilateral abcd is
+	// locally Delaunay, with the tie broken as given (see
+	// Preferred_directions).
+	template<class P>
+	bool break_tie( const P& a, const P& b, const P& c, const P& d,
+			const Preferred_directions& tie, ra::math::certain_sign (&)[4] ) {
+		return is_preferred_diagonal(a,c,d,b,tie.u,tie.v);
+	}
+
+	template<class P>
+	bool break_tie( const P& a, const P& b, const P& c, const P& d,
+			const Perturbation& tie, ra::math::certain_sign (&orientations)[4] ) {
+		return perturbed_side( a, b, c, d, tie, orientations ) < 0;
+	}
+
+	// Decide a predicate with stage K and, if it is uncertain, the stages
+	// after it. apply calls the predicate on a stage.
+	template<std::size_t K, class F>
+	int decide( Predicate predicate, const F& apply ) const {
+#if RA_GEOMETRY_STATS
+		Counters::increment( predicate * num_stages + K );
+#endif
+		ra::math::certain_sign sign = apply( std::get<K>(filters_) );
+		if constexpr( K + 1 < num_stages ){
+			if( sign == ra::math::certain_sign::uncertain ){
+				return decide<K + 1>( predicate, apply );
+			}
+		}
+		return static_cast<int>(sign);
+	}
+
+	// Decide n batched tests of a predicate on points with N indices each
+	// (see orientation_batch). batch calls the batched test of the first
+	// stage on tests k to k + m - 1; apply calls the test of a stage on
+	// the points of one test.
+	template<std::size_t N, class Index, class Result, class Batch, class Apply>
+	void decide_batch( Predicate predicate, const Real* x, const Real* y,
+			const Index (*indices)[N], std::size_t n, Result* result, const Batch& batch,
+			const Apply& apply ) {
+		using First = std::tuple_element_t<0, Filter_chain>;
+		if constexpr( has_batch<First, Real, Index>::value ){
+			constexpr std::size_t block_size = 256;
+			ra::math::certain_sign signs[block_size];
+			for( std::size_t k = 0; k < n; k += block_size ){
+				std::size_t m = std::min(block_size, n - k);
+#if RA_GEOMETRY_STATS
+				Counters::increment( predicate * num_stages, m );
+#endif
+				batch( std::get<0>(filters_), k, m, signs );
+				for( std::size_t j = 0; j < m; ++j ){
+					int sign = static_cast<int>(signs[j]);
+					if constexpr( num_stages > 1 ){
+						if( signs[j] == ra::math::certain_sign::uncertain ){
+							plain_point<Real> p[N];
+							points_of( x, y, indices[k + j], p );
+							sign = decide<1>( predicate, [&]( const auto& filter ){
+								return apply( filter, p );
+							});
+						}
+					}
+					result[k + j] = Result(sign);
+				}
+			}
+		}else{
+			for( std::size_t k = 0; k < n; ++k ){
+				plain_point<Real> p[N];
+				points_of( x, y, indices[k], p );
+				result[k] = Result(decide<0>( predicate, [&]( const auto& filter ){
+					return apply( filter, p );
+				}));
+			}
+		}
+	}
+
+	template<std::size_t N, class Index>
+	static void points_of( const Real* x, const Real* y, const Index (&indices)[N],
+			plain_point<Real> (&p)[N] ) {
+		for( std::size_t i = 0; i < N; ++i ){
+			p[i] = plain_point<Real> {x[indices[i]], y[indices[i]]};
+		}
+	}
+
+	template<std::size_t... K>
+	static constexpr std::array<filter_kind, num_stages> stage_kinds( std::index_sequence<K...> ){
+		return {std::tuple_element_t<K, Filter_chain>::kind...};
+	}
+
+	// The index of the first stage of the given kind, or num_stages if
+	// there is none.
+	static constexpr std::size_t first_stage( filter_kind kind ){
+		constexpr std::array<filter_kind, num_stages> kinds =
+		  stage_kinds( std::make_index_sequence<num_stages>() );
+		for( std::size_t k = 0; k < num_stages; ++k ){
+			if( kinds[k] == kind ){
+				return k;
+			}
+		}
+		return num_stages;
+	}
+
+	// The number of tests of a predicate that reached the first stage of
+	// the given kind, or 0 if there is no such stage.
+	static std::size_t count( const typename Counters::counts& counts, Predicate predicate,
+			filter_kind kind ){
+		std::size_t stage = first_stage( kind );
+		return (stage == num_stages) ? 0 : counts[predicate * num_stages + stage];
+	}
+
+	static Statistics to_statistics( const typename Counters::counts& counts ) {
+		return Statistics {counts[orientation_predicate * num_stages],
+		  count(counts, orientation_predicate, filter_kind::exact),
+		  counts[preferred_direction_predicate * num_stages],
+		  count(counts, preferred_direction_predicate, filter_kind::exact),
+		  counts[side_of_oriented_circle_predicate * num_stages],
+		  count(counts, side_of_oriented_circle_predicate, filter_kind::exact),
+		  count(counts, orientation_predicate, filter_kind::interval),
+		  count(counts, side_of_oriented_circle_predicate, filter_kind::interval),
+		  count(counts, orientation_predicate, filter_kind::double_double),
+		  count(counts, preferred_direction_predicate, filter_kind::double_double),
+		  count(counts, side_of_oriented_circle_predicate, filter_kind::double_double),
+		  counts[cache_hit_counter],
+		  counts[cache_miss_counter],
+		  count(counts, preferred_direction_predicate, filter_kind::interval)};
+	}
+
+	template<std::size_t... K>
+	static Chain_statistics to_stage_statistics( const typename Counters::counts& counts,
+			std::index_sequence<K...> ) {
+		return Chain_statistics {Stage_statistics {std::tuple_element_t<K, Filter_chain>::name,
+		  counts[orientation_predicate * num_stages + K],
+		  counts[preferred_direction_predicate * num_stages + K],
+		  counts[side_of_oriented_circle_predicate * num_stages + K]}...};
+	}
 };
 }
@@ -0,0 +1,160 @@
+#ifndef ra_packed_interval_hpp
+#define ra_packed_interval_hpp
+
+#include "ra/interval.hpp"
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+namespace ra::math {
+
+// The bounds are stored as the negated lower bound and the upper bound,
+// packed into a single SSE2 register (lane 0 holds -lower, lane 1 holds
+// upper). Like negated_lower_storage, everything is rounded upward, and
+// both bounds of a sum or difference are produced by one packed addition.
+// Only available for interval<double> on targets with SSE2.
+struct packed_storage {};
+
+// Pin a packed value in a register (see force_rounding).
+inline __m128d force_rounding( __m128d x ) {
+#if defined(__GNUC__)
+	asm volatile( "" : "+x"(x) : : "memory" );
+#else
+	volatile __m128d y = x;
+	x = y;
+#endif
+	return x;
+}
+
+template<class Rounding>
+class interval<double, Rounding, packed_storage> :
+  public interval_statistics<interval<double, Rounding, packed_storage>> {
+	public:
+		using real_type = double;
+
+		using rounding_policy = Rounding;
+
+		using storage_policy = packed_storage;
+
+		using typename interval_statistics<interval>::statistics;
+		using interval_statistics<interval>::clear_statistics;
+		using interval_statistics<interval>::get_statistics;
+		using interval_statistics<interval>::get_thread_statistics;
+		using interval_statistics<interval>::record_indeterminate_result;
+		using interval_statistics<interval>::record_arithmetic_op;
+
+		//Default constructor
+		interval( real_type init = real_type(0) ) : bounds_ {_mm_set_pd(init, -init)} {}
+
+		//Two argument constructor
+		interval( real_type bot, real_type top ) : bounds_ {_mm_set_pd(top, -bot)} {
+			assert( bot <= top );
+		}
+
+		interval& operator +=( const interval& other ) {
+			// Hold users rounding mode; round upward throughout
+			[[maybe_unused]] typename Rounding::upward_guard rounding_guard;
+
+			// [-a.lower + -b.lower, a.upper + b.upper]
+			bounds_ = force_rounding( _mm_add_pd( force_rounding(bounds_),
+			  force_rounding(other.bounds_) ) );
+
+			// Record arithmetic operation
+			record_arithmetic_op();
+			return *this;
+		}
+
+		interval& operator -=( const interval& other ) {
+			// Hold users rounding mode; round upward throughout
+			[[maybe_unused]] typename Rounding::upward_guard rounding_guard;
+
+			// [-a.lower + b.upper, a.upper + -b.lower]
+			__m128d swapped = _mm_shuffle_pd( other.bounds_, other.bounds_, 1 );
+			bounds_ = force_rounding( _mm_add_pd( force_rounding(bounds_),
+			  force_rounding(swapped) ) );
+
+			// Record arithmetic operation
+			record_arithmetic_op();
+			return *this;
+		}
+
+		interval& operator *=( const interval& other ) {
+			// Hold users rounding mode; round upward throughout
+			[[maybe_unused]] typename Rounding::upward_guard rounding_guard;
+
+			// Let a be stored as (na, ah) with na = -a.lower, and b as
+			// (nb, bh). The upper bound is the largest of the four endpoint
+			// products and -lower is the largest of their negations. Each
+			// candidate is a product of (possibly negated) stored values,
+			// so it is rounded in the right direction:
+			//   x1 = ( na,  na) * (bh, nb) = ( na*bh,  na*nb)
+			//   x2 = ( ah,  ah) * (nb, bh) = ( ah*nb,  ah*bh)
+			//   x3 = (-na, -na) * (nb, bh) = (-na*nb, -na*bh)
+			//   x4 = (-ah, -ah) * (bh, nb) = (-ah*bh, -ah*nb)
+			// The result is the lane-wise maximum of x1..x4, computed without
+			// branching on the signs of the operands.
+			__m128d a = force_rounding( bounds_ );
+			__m128d b = force_rounding( other.bounds_ );
+			__m128d b_swapped = _mm_shuffle_pd( b, b, 1 );
+			__m128d sign = _mm_set1_pd( -0.0 );
+			__m128d na = _mm_unpacklo_pd( a, a );
+			__m128d ah = _mm_unpackhi_pd( a, a );
+			__m128d x1 = _mm_mul_pd( na, b_swapped );
+			__m128d x2 = _mm_mul_pd( ah, b );
+			__m128d x3 = _mm_mul_pd( _mm_xor_pd(na, sign), b );
+			__m128d x4 = _mm_mul_pd( _mm_xor_pd(ah, sign), b_swapped );
+			bounds_ = force_rounding( _mm_max_pd( _mm_max_pd(x1, x2),
+			  _mm_max_pd(x3, x4) ) );
+
+			// Record arithmetic operation
+			record_arithmetic_op();
+			return *this;
+		}
+
+		real_type lower() const { return -_mm_cvtsd_f64(bounds_); }
+
+		real_type upper() const { return _mm_cvtsd_f64( _mm_unpackhi_pd(bounds_, bounds_) ); }
+
+		bool is_singleton() const { return upper() == lower(); }
+
+		int sign() const {
+			certain_sign result = sign_or_uncertain();
+			if( result == certain_sign::uncertain ) {
+				throw indeterminate_result {"Cannot determine sign of interval"};
+			}
+			return static_cast<int>(result);
+		}
+
+		certain_sign sign_or_uncertain() const {
+			if( upper() < 0 ) {
+				return certain_sign::negative;
+			}else if( lower() > 0 ) {
+				return certain_sign::positive;
+			}else if( (lower() == 0) && (upper() == 0) ) {
+				return certain_sign::zero;
+			}else {
+				// Record indeterminate result
+				record_indeterminate_result();
+				return certain_sign::uncertain;
+			}
+		}
+
+		bool certainly_negative() const { return upper() < 0; }
+		bool certainly_positive() const { return lower() > 0; }
+		bool certainly_zero() const { return (lower() == 0) && (upper() == 0); }
+		bool possibly_zero() const { return (lower() <= 0) && (upper() >= 0); }
+
+		bool operator == ( const interval& other ) const { return (upper() == other.upper()) && (lower() == other.lower()); }
+
+		static real_type zero() { return real_type(0); }
+
+	private:
+		// Lane 0 holds -lower, lane 1 holds upper.
+		__m128d bounds_;
+};
+}
+
+#endif
+
+#endif
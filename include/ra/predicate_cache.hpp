@@ -0,0 +1,105 @@
+#ifndef ra_predicate_cache_hpp
+#define ra_predicate_cache_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ra::geometry {
+
+// What a vertex keeps for the predicate cache (see Kernel::Point_cache):
+// a generation, which Kernel::invalidate_predicate_cache advances when
+// the point of the vertex changes, so that outcomes found for an earlier
+// point are not taken for those of the current one.
+class point_cache {
+	public:
+		point_cache() = default;
+
+		// Start a new generation.
+		void invalidate(){ ++generation_; }
+
+		std::uint32_t generation() const { return generation_; }
+
+	private:
+		std::uint32_t generation_ = 0;
+};
+
+// A bounded, direct-mapped cache of the outcomes of a predicate on four
+// vertices (see Kernel::enable_predicate_cache). An outcome is stored
+// under the 32-bit ids of the vertices, in an order chosen by the caller,
+// and a stamp that must change whenever any of the vertices does (such
+// as the sum of their point_cache generations); a lookup finds it only
+// if both are the same. The ids must not be all equal, as those of an
+// empty slot are. Each key maps to one slot, and a new outcome replaces
+// whatever was in its slot, so the cache never grows and a lookup is a
+// single comparison. Outcomes are a few bits, given as an unsigned char;
+// a slot takes 24 bytes.
+class quad_cache {
+	public:
+		// A default-constructed cache has no slots, and is disabled.
+		quad_cache() = default;
+
+		// Whether the cache has any slots.
+		bool enabled() const { return !slots_.empty(); }
+
+		// Give the cache 2^log2_size slots, all empty, or none if log2_size
+		// is zero.
+		void resize( unsigned log2_size ){
+			slots_.assign( (log2_size == 0) ? 0 : (std::size_t(1) << log2_size), slot {} );
+			shift_ = 64 - log2_size;
+		}
+
+		// Empty every slot.
+		void clear(){
+			slots_.assign( slots_.size(), slot {} );
+		}
+
+		// Find the outcome stored for the ids and stamp. Requires
+		// enabled().
+		bool find( const std::uint32_t (&ids)[4], std::uint32_t stamp,
+				unsigned char& outcome ) const {
+			const slot& s = slots_[index(ids)];
+			if( (s.stamp == stamp) && (s.ids[0] == ids[0]) && (s.ids[1] == ids[1])
+					&& (s.ids[2] == ids[2]) && (s.ids[3] == ids[3]) ){
+				outcome = s.outcome;
+				return true;
+			}
+			return false;
+		}
+
+		// Store the outcome for the ids and stamp, replacing the outcome
+		// in its slot. Requires enabled().
+		void insert( const std::uint32_t (&ids)[4], std::uint32_t stamp,
+				unsigned char outcome ){
+			slot& s = slots_[index(ids)];
+			s.ids[0] = ids[0];
+			s.ids[1] = ids[1];
+			s.ids[2] = ids[2];
+			s.ids[3] = ids[3];
+			s.stamp = stamp;
+			s.outcome = outcome;
+		}
+
+	private:
+		struct slot {
+			std::uint32_t ids[4] = {0, 0, 0, 0};
+			std::uint32_t stamp = 0;
+			unsigned char outcome = 0;
+		};
+
+		// The slot of the ids: the high bits of a multiplicative hash
+		// (Fibonacci hashing) of the ids packed two to a word.
+		std::size_t index( const std::uint32_t (&ids)[4] ) const {
+			std::uint64_t low = (std::uint64_t(ids[0]) << 32) | ids[1];
+			std::uint64_t high = (std::uint64_t(ids[2]) << 32) | ids[3];
+			std::uint64_t h = ((low * UINT64_C(0x9e3779b97f4a7c15)) ^ high)
+			  * UINT64_C(0x9e3779b97f4a7c15);
+			return std::size_t(h >> shift_);
+		}
+
+		std::vector<slot> slots_;
+		unsigned shift_ = 64;
+};
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef ra_rounding_hpp
+#define ra_rounding_hpp
+
+#include <cfenv>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ra::math {
+
+// The exception thrown when the floating-point rounding mode cannot be
+// changed.
+struct rounding_error : public std::runtime_error
+{
+	using std::runtime_error::runtime_error;
+};
+
+// Get the current floating-point rounding mode.
+inline int get_rounding_mode() { return std::fegetround(); }
+
+// Set the floating-point rounding mode.
+// This is always performed (it does not vanish under NDEBUG), and a
+// failure to change the mode throws rounding_error.
+inline void set_rounding_mode( int mode ) {
+	if( std::fesetround(mode) ) {
+		throw rounding_error {"Cannot set floating-point rounding mode"};
+	}
+}
+
+// Force a value to be materialized at this point in the program.
+// Even with -frounding-math, an optimizing compiler will happily evaluate
+// a floating-point operation at compile time or schedule it across a call
+// to set_rounding_mode. Passing the operands and the result of an
+// operation through this barrier pins the operation between the mode
+// changes that surround it.
+template<typename T>
+inline T force_rounding( T x ) {
+#if defined(__GNUC__) && defined(__SSE2__)
+	if constexpr( std::is_same_v<T, float> || std::is_same_v<T, double> ) {
+		asm volatile( "" : "+x"(x) : : "memory" );
+	} else {
+		asm volatile( "" : "+m"(x) : : "memory" );
+	}
+#elif defined(__GNUC__)
+	asm volatile( "" : "+m"(x) : : "memory" );
+#else
+	volatile T y = x;
+	x = y;
+#endif
+	return x;
+}
+
+// Arithmetic in the current rounding mode, pinned by force_rounding.
+template<typename T>
+inline T add_rounded( T a, T b ) { return force_rounding( force_rounding(a) + force_rounding(b) ); }
+
+template<typename T>
+inline T sub_rounded( T a, T b ) { return force_rounding( force_rounding(a) - force_rounding(b) ); }
+
+template<typename T>
+inline T mul_rounded( T a, T b ) { return force_rounding( force_rounding(a) * force_rounding(b) ); }
+
+// A protected rounding region.
+// On construction the caller's rounding mode is saved and the mode is set
+// to upward rounding (or to the given mode); on destruction the caller's
+// mode is restored. Code that evaluates a whole expression in interval
+// arithmetic (such as a geometric predicate) can hold a region for the
+// duration of the evaluation and use the protected_rounding policy, so
+// that individual operations do not touch the floating-point environment
+// at all.
+class rounding_region {
+	public:
+		explicit rounding_region( int mode = FE_UPWARD ) :
+		  user_rounding_mode_ {get_rounding_mode()} {
+			set_rounding_mode(mode);
+		}
+
+		// Restoring a mode that was previously in effect cannot fail.
+		~rounding_region() { std::fesetround(user_rounding_mode_); }
+
+		// A region is tied to the scope that created it.
+		rounding_region(const rounding_region&) = delete;
+		rounding_region& operator=(const rounding_region&) = delete;
+
+	private:
+		int user_rounding_mode_;
+};
+
+// Rounding policies for interval arithmetic.
+// A rounding policy provides the directed-rounding primitives used to
+// compute interval bounds, and guard types that an interval operation
+// holds for its duration: guard for operations that use the primitives,
+// and upward_guard for operations that use plain upward-rounded
+// arithmetic (add_rounded and friends) throughout. sets_rounding_mode
+// tells whether each primitive changes the floating-point environment.
+
+// Every operation saves the caller's rounding mode, switches to downward
+// rounding for the lower bound and upward rounding for the upper bound,
+// and restores the caller's mode. Usable anywhere.
+template<typename T>
+struct checked_rounding {
+	static constexpr bool sets_rounding_mode = true;
+
+	class guard {
+		public:
+			guard() : user_rounding_mode_ {get_rounding_mode()} {}
+			~guard() { std::fesetround(user_rounding_mode_); }
+			guard(const guard&) = delete;
+			guard& operator=(const guard&) = delete;
+		private:
+			int user_rounding_mode_;
+	};
+
+	// Held by an operation that only ever rounds upward; the mode is set
+	// once on construction.
+	class upward_guard {
+		public:
+			upward_guard() : user_rounding_mode_ {get_rounding_mode()} {
+				set_rounding_mode(FE_UPWARD);
+			}
+			~upward_guard() { std::fesetround(user_rounding_mode_); }
+			upward_guard(const upward_guard&) = delete;
+			upward_guard& operator=(const upward_guard&) = delete;
+		private:
+			int user_rounding_mode_;
+	};
+
+	static T add_down( T a, T b ) { set_rounding_mode(FE_DOWNWARD); return add_rounded(a, b); }
+	static T add_up( T a, T b ) { set_rounding_mode(FE_UPWARD); return add_rounded(a, b); }
+	static T sub_down( T a, T b ) { set_rounding_mode(FE_DOWNWARD); return sub_rounded(a, b); }
+	static T sub_up( T a, T b ) { set_rounding_mode(FE_UPWARD); return sub_rounded(a, b); }
+	static T mul_down( T a, T b ) { set_rounding_mode(FE_DOWNWARD); return mul_rounded(a, b); }
+	static T mul_up( T a, T b ) { set_rounding_mode(FE_UPWARD); return mul_rounded(a, b); }
+};
+
+// Operations assume that the rounding mode is already upward, as it is
+// inside a rounding_region, and never touch the floating-point
+// environment. Downward-rounded results are obtained by negating an
+// upward-rounded result (e.g., down(a + b) == -up(-a - b)).
+template<typename T>
+struct protected_rounding {
+	static constexpr bool sets_rounding_mode = false;
+
+	struct guard {};
+	struct upward_guard {};
+
+	static T add_down( T a, T b ) { return -add_rounded(-a, -b); }
+	static T add_up( T a, T b ) { return add_rounded(a, b); }
+	static T sub_down( T a, T b ) { return -sub_rounded(-a, -b); }
+	static T sub_up( T a, T b ) { return sub_rounded(a, b); }
+	static T mul_down( T a, T b ) { return -mul_rounded(-a, b); }
+	static T mul_up( T a, T b ) { return mul_rounded(a, b); }
+};
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef ra_statistics_hpp
+#define ra_statistics_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Statistics gathering for ra::math::interval and ra::geometry::Kernel.
+// When RA_GEOMETRY_STATS is 0, all counting code is compiled out: the
+// get_statistics/clear_statistics API remains available, but every count
+// reads as zero. Statistics are enabled by default.
+#ifndef RA_GEOMETRY_STATS
+#define RA_GEOMETRY_STATS 1
+#endif
+
+namespace ra::math {
+
+// A set of N event counters shared by all threads.
+// Each thread counts into its own block of counters, so counting needs no
+// synchronization and threads do not contend for cache lines. A block is
+// registered with the registry on first use in a thread; when the thread
+// exits, its counts are folded into the registry and the block goes away.
+// Tag distinguishes independent sets of counters (e.g., one per interval
+// type).
+template<class Tag, std::size_t N>
+class counter_registry {
+	public:
+		using counts = std::array<unsigned long, N>;
+
+		// Count one event (or count events) of kind i in the calling
+		// thread.
+		static void increment( std::size_t i, unsigned long count = 1 ) {
+			// Only the owning thread writes to its block outside of clear(),
+			// so a relaxed load and store is enough (and is much cheaper than
+			// an atomic read-modify-write).
+			std::atomic<unsigned long>& c = local().counters_[i];
+			c.store( c.load(std::memory_order_relaxed) + count, std::memory_order_relaxed );
+		}
+
+		// Get the counts summed over all threads, including threads that
+		// have exited.
+		static void merged( counts& result ) {
+			registry& r = get_registry();
+			std::lock_guard<std::mutex> lock(r.mutex_);
+			result = r.retired_;
+			for( const block* b : r.blocks_ ) {
+				b->add_to( result );
+			}
+		}
+
+		// Get the counts of the calling thread only.
+		static void thread_local_counts( counts& result ) {
+			result.fill(0);
+			local().add_to( result );
+		}
+
+		// Reset the counts of all threads.
+		// Events counted concurrently with a clear may or may not be kept.
+		static void clear() {
+			registry& r = get_registry();
+			std::lock_guard<std::mutex> lock(r.mutex_);
+			r.retired_.fill(0);
+			for( block* b : r.blocks_ ) {
+				for( auto& c : b->counters_ ) {
+					c.store( 0, std::memory_order_relaxed );
+				}
+			}
+		}
+
+	private:
+		class block;
+
+		struct registry {
+			std::mutex mutex_;
+			std::vector<block*> blocks_;
+			counts retired_ {};
+		};
+
+		// The registry is constructed before the first block registers,
+		// so it outlives every block.
+		static registry& get_registry() {
+			static registry r;
+			return r;
+		}
+
+		class block {
+			public:
+				block() {
+					for( auto& c : counters_ ) {
+						c.store( 0, std::memory_order_relaxed );
+					}
+					registry& r = get_registry();
+					std::lock_guard<std::mutex> lock(r.mutex_);
+					r.blocks_.push_back( this );
+				}
+
+				~block() {
+					registry& r = get_registry();
+					std::lock_guard<std::mutex> lock(r.mutex_);
+					add_to( r.retired_ );
+					for( auto it = r.blocks_.begin(); it != r.blocks_.end(); ++it ) {
+						if( *it == this ) {
+							r.blocks_.erase( it );
+							break;
+						}
+					}
+				}
+
+				block(const block&) = delete;
+				block& operator=(const block&) = delete;
+
+				void add_to( counts& result ) const {
+					for( std::size_t i = 0; i < N; ++i ) {
+						result[i] += counters_[i].load( std::memory_order_relaxed );
+					}
+				}
+
+				// Keep blocks of different threads on different cache lines.
+				alignas(64) std::array<std::atomic<unsigned long>, N> counters_;
+		};
+
+		static block& local() {
+			static thread_local block b;
+			return b;
+		}
+};
+}
+
+#endif